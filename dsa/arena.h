@@ -13,6 +13,14 @@
  * @file arena.h
  * @brief Arena allocator
  *
+ * The arena either allocates from a fixed backing buffer given by the user
+ * (`arena_init`), or from a large range of virtual memory, which is reserved
+ * up front and committed in growing steps as the arena fills up
+ * (`arena_init_virtual`). In the latter case, allocations never move, and the
+ * arena only uses as much physical memory as has been allocated. Committing
+ * only happens when an allocation does not fit, so the bump-pointer path is
+ * the same for both.
+ *
  * For a comprehensive source, read:
  * @li https://www.gingerbill.org/article/2019/02/08/memory-allocation-strategies-002/
  */
@@ -30,14 +38,78 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(MAP_ANONYMOUS) || defined(MAP_ANON)
+/// @cond DO_NOT_DOCUMENT
+#define ARENA_HAS_VIRTUAL_MEMORY
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+/// @endcond
+#endif
+#endif
+
+/**
+ * @def ARENA_MIN_COMMIT_LEN
+ * @brief Minimum number of bytes committed at a time by an arena with
+ *        reserved virtual memory. Defaults to 64 KiB.
+ */
+#ifndef ARENA_MIN_COMMIT_LEN
+#define ARENA_MIN_COMMIT_LEN ((size_t)64 * 1024)
+#endif
+
+/**
+ * @def ARENA_ZERO_MEMORY
+ * @brief Whether `arena_allocate` / `arena_reallocate` (and their aligned
+ *        versions) zero out the returned memory. Defaults to 1.
+ *
+ * Define it as 0 to skip the `memset`, if allocations are always written to
+ * before being read. The `_uninit` functions never zero the memory.
+ */
+#ifndef ARENA_ZERO_MEMORY
+#define ARENA_ZERO_MEMORY 1
+#endif
+
+/**
+ * @def ARENA_STATS
+ * @brief Define it to record usage statistics in every arena, which can be
+ *        queried with `arena_get_stats`. Not defined by default, in which case
+ *        the statistics are compiled out.
+ *
+ * @warning It changes the layout of `struct arena`, so it must be defined the
+ *          same way in every translation unit sharing arenas.
+ */
+#ifdef DOXYGEN
+#define ARENA_STATS
+#endif
+
+#ifdef ARENA_STATS
+/**
+ * @brief Arena usage statistics struct. Only available if `ARENA_STATS` is
+ *        defined.
+ */
+struct arena_stats {
+    size_t high_water_mark;         ///< Highest offset reached, i.e. the buffer length the arena needed.
+    size_t allocation_count;        ///< Number of successful allocations, including moving reallocations.
+    size_t padding_bytes;           ///< Number of bytes lost to alignment padding.
+    size_t failed_allocation_count; ///< Number of allocations and reallocations which ran out of memory.
+};
+#endif
+
 /**
  * @brief Arena data struct.
  */
 struct arena {
-    size_t buf_len;         ///< Underlying buffer length.
+    size_t buf_len;         ///< Underlying buffer length (committed length with reserved virtual memory).
     size_t prev_offset;     ///< Previous offset relative to buf_ptr.
     size_t curr_offset;     ///< Current offset relative to buf_ptr.
     unsigned char *buf_ptr; ///< Underlying buffer pointer.
+    size_t reserve_len;     ///< Reserved virtual memory length. 0 with a fixed backing buffer.
+#ifdef ARENA_STATS
+    struct arena_stats stats; ///< Usage statistics.
+#endif
 };
 
 /**
@@ -49,6 +121,51 @@ struct temp_arena_state {
     size_t curr_offset;      ///< Arena curr offset.
 };
 
+/// @cond DO_NOT_DOCUMENT
+static inline void internal_arena_stats_reset(struct arena *self)
+{
+#ifdef ARENA_STATS
+    memset(&self->stats, 0, sizeof(self->stats));
+#else
+    (void)(self);
+#endif
+}
+
+static inline void internal_arena_stats_on_allocate(struct arena *self, const size_t padding)
+{
+#ifdef ARENA_STATS
+    self->stats.allocation_count++;
+    self->stats.padding_bytes += padding;
+    if (self->curr_offset > self->stats.high_water_mark) {
+        self->stats.high_water_mark = self->curr_offset;
+    }
+#else
+    (void)(self);
+    (void)(padding);
+#endif
+}
+
+static inline void internal_arena_stats_on_resize(struct arena *self)
+{
+#ifdef ARENA_STATS
+    if (self->curr_offset > self->stats.high_water_mark) {
+        self->stats.high_water_mark = self->curr_offset;
+    }
+#else
+    (void)(self);
+#endif
+}
+
+static inline void internal_arena_stats_on_failure(struct arena *self)
+{
+#ifdef ARENA_STATS
+    self->stats.failed_allocation_count++;
+#else
+    (void)(self);
+#endif
+}
+/// @endcond
+
 /**
  * @brief Initialize the arena.
  *
@@ -69,53 +186,198 @@ static inline void arena_init(struct arena *self, const size_t len, unsigned cha
     self->buf_len = len - padding;
     self->curr_offset = 0;
     self->prev_offset = 0;
+    self->reserve_len = 0;
+
+    internal_arena_stats_reset(self);
 }
 
 /**
- * @brief Deallocate all allocations in the arena.
+ * @brief Initialize the arena with a range of reserved virtual memory, which
+ *        is committed on demand.
+ *
+ * Reserving costs no physical memory, so `reserve_len` can be chosen as an
+ * upper bound, e.g. several GiB on 64-bit platforms.
  *
  * @param[in] self              Arena pointer.
+ * @param[in] reserve_len       Length of virtual memory to reserve. Rounded up to the page size.
+ *
+ * @return                      Whether the memory could be reserved.
+ * @retval false
+ *   @li                        If reserve_len is 0.
+ *   @li                        If mmap fails, or virtual memory is not supported on the platform.
  */
-static inline void arena_deallocate_all(struct arena *self)
+static inline bool arena_init_virtual(struct arena *self, const size_t reserve_len)
 {
     assert(self);
 
+#ifdef ARENA_HAS_VIRTUAL_MEMORY
+    const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+    if (reserve_len == 0 || reserve_len > SIZE_MAX - page_size) {
+        return false;
+    }
+
+    const size_t len = (reserve_len + page_size - 1) / page_size * page_size;
+
+    void *ptr = mmap(NULL, len, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+    if (ptr == MAP_FAILED) {
+        return false;
+    }
+
+    self->buf_ptr = (unsigned char *)ptr;
+    self->buf_len = 0;
     self->curr_offset = 0;
     self->prev_offset = 0;
+    self->reserve_len = len;
+
+    internal_arena_stats_reset(self);
+
+    return true;
+#else
+    (void)(self);
+    (void)(reserve_len);
+    return false;
+#endif
 }
 
 /**
- * @brief Get the pointer to a chunk of the arena. With specific alignment.
+ * @brief Release the virtual memory of an arena initialized with
+ *        `arena_init_virtual`.
  *
- * @param[in] self              arena pointer.
- * @param[in] alignment         alignment size
- * @param[in] size              chunk size
+ * @param[in] self              Arena pointer.
+ */
+static inline void arena_deinit_virtual(struct arena *self)
+{
+    assert(self);
+    assert(self->reserve_len > 0);
+
+#ifdef ARENA_HAS_VIRTUAL_MEMORY
+    munmap(self->buf_ptr, self->reserve_len);
+#endif
+
+    self->buf_ptr = NULL;
+    self->buf_len = 0;
+    self->curr_offset = 0;
+    self->prev_offset = 0;
+    self->reserve_len = 0;
+}
+
+/// @cond DO_NOT_DOCUMENT
+/* commit at least min_len bytes of the reserved memory. the committed length is at least doubled */
+static inline bool internal_arena_commit(struct arena *self, const size_t min_len)
+{
+#ifdef ARENA_HAS_VIRTUAL_MEMORY
+    if (self->reserve_len == 0 || min_len > self->reserve_len) {
+        return false;
+    }
+
+    const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+    size_t len = self->buf_len < self->reserve_len / 2 ? 2 * self->buf_len : self->reserve_len;
+    len = len < min_len ? min_len : len;
+    len = len < ARENA_MIN_COMMIT_LEN ? ARENA_MIN_COMMIT_LEN : len;
+    len = (len + page_size - 1) / page_size * page_size;
+    len = len < self->reserve_len ? len : self->reserve_len;
+
+    if (mprotect(&self->buf_ptr[self->buf_len], len - self->buf_len, PROT_READ | PROT_WRITE) != 0) {
+        return false;
+    }
+
+    self->buf_len = len;
+
+    return true;
+#else
+    (void)(self);
+    (void)(min_len);
+    return false;
+#endif
+}
+/// @endcond
+
+/**
+ * @brief Deallocate all allocations in the arena.
  *
- * @return                      A pointer to a zeroed-out memory chunk.
- * @retval NULL                 If the arena doesn't have enough memory for the allocation.
+ * @param[in] self              Arena pointer.
  */
-static inline void *arena_allocate_aligned(struct arena *self, const size_t alignment, const size_t size)
+static inline void arena_deallocate_all(struct arena *self)
 {
     assert(self);
 
+    self->curr_offset = 0;
+    self->prev_offset = 0;
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline void *internal_arena_allocate_aligned(struct arena *self, const size_t alignment, const size_t size,
+                                                    const bool zero)
+{
     void *ptr = (void *)&self->buf_ptr[self->curr_offset];
 
     size_t space_left = self->buf_len - (size_t)self->curr_offset;
 
     const bool has_space_left = align(alignment, size, &ptr, &space_left);
     if (!has_space_left) {
-        return NULL;
+        const bool fits_reserve = size <= self->reserve_len && alignment <= self->reserve_len - size
+                                  && self->curr_offset <= self->reserve_len - size - alignment;
+
+        if (!fits_reserve || !internal_arena_commit(self, self->curr_offset + alignment + size)) {
+            internal_arena_stats_on_failure(self);
+            return NULL;
+        }
+        return internal_arena_allocate_aligned(self, alignment, size, zero);
     }
 
     const uintptr_t relative_offset = (uintptr_t)((unsigned char *)ptr - &self->buf_ptr[0]);
+    const size_t padding = relative_offset - self->curr_offset;
 
     self->prev_offset = relative_offset;
     self->curr_offset = relative_offset + size;
 
-    memset(ptr, 0, size);
+    internal_arena_stats_on_allocate(self, padding);
+
+    if (zero) {
+        memset(ptr, 0, size);
+    }
 
     return ptr;
 }
+/// @endcond
+
+/**
+ * @brief Get the pointer to a chunk of the arena. With specific alignment.
+ *
+ * @param[in] self              arena pointer.
+ * @param[in] alignment         alignment size
+ * @param[in] size              chunk size
+ *
+ * @return                      A pointer to a zeroed-out memory chunk (uninitialized if `ARENA_ZERO_MEMORY` is 0).
+ * @retval NULL                 If the arena doesn't have enough memory for the allocation.
+ */
+static inline void *arena_allocate_aligned(struct arena *self, const size_t alignment, const size_t size)
+{
+    assert(self);
+
+    return internal_arena_allocate_aligned(self, alignment, size, ARENA_ZERO_MEMORY);
+}
+
+/**
+ * @brief Get the pointer to an uninitialized chunk of the arena. With specific
+ *        alignment.
+ *
+ * @param[in] self              arena pointer.
+ * @param[in] alignment         alignment size
+ * @param[in] size              chunk size
+ *
+ * @return                      A pointer to an uninitialized memory chunk.
+ * @retval NULL                 If the arena doesn't have enough memory for the allocation.
+ */
+static inline void *arena_allocate_aligned_uninit(struct arena *self, const size_t alignment, const size_t size)
+{
+    assert(self);
+
+    return internal_arena_allocate_aligned(self, alignment, size, false);
+}
 
 /**
  * @brief Get the pointer to a chunk of the arena.
@@ -123,7 +385,7 @@ static inline void *arena_allocate_aligned(struct arena *self, const size_t alig
  * @param[in] self              The arena pointer.
  * @param[in] size              The section size in bytes.
  *
- * @return                      A pointer to a zeroed-out memory chunk.
+ * @return                      A pointer to a zeroed-out memory chunk (uninitialized if `ARENA_ZERO_MEMORY` is 0).
  * @retval NULL                 If the arena doesn't have enough memory for the allocation.
  */
 static inline void *arena_allocate(struct arena *self, const size_t size)
@@ -133,44 +395,55 @@ static inline void *arena_allocate(struct arena *self, const size_t size)
     return arena_allocate_aligned(self, alignof(max_align_t), size);
 }
 
+/**
+ * @brief Get the pointer to an uninitialized chunk of the arena.
+ *
+ * @param[in] self              The arena pointer.
+ * @param[in] size              The section size in bytes.
+ *
+ * @return                      A pointer to an uninitialized memory chunk.
+ * @retval NULL                 If the arena doesn't have enough memory for the allocation.
+ */
+static inline void *arena_allocate_uninit(struct arena *self, const size_t size)
+{
+    assert(self);
+
+    return arena_allocate_aligned_uninit(self, alignof(max_align_t), size);
+}
+
 /// @cond DO_NOT_DOCUMENT
 static inline void *internal_arena_try_optimizing_w_prev_offset(struct arena *self, unsigned char *old_ptr,
-                                                                const size_t old_size, const size_t new_size)
+                                                                const size_t old_size, const size_t new_size,
+                                                                const bool zero)
 {
     if (&self->buf_ptr[self->prev_offset] != old_ptr) {
         return NULL;
     }
 
+    if (new_size > self->buf_len - self->prev_offset) {
+        const bool fits_reserve = self->reserve_len != 0 && new_size <= self->reserve_len - self->prev_offset;
+
+        if (!fits_reserve || !internal_arena_commit(self, self->prev_offset + new_size)) {
+            return NULL;
+        }
+    }
+
     self->curr_offset = self->prev_offset + new_size;
 
-    if (new_size > old_size) {
+    internal_arena_stats_on_resize(self);
+
+    if (zero && new_size > old_size) {
         const size_t diff = new_size - old_size;
 
-        memset(&self->buf_ptr[self->curr_offset], 0, diff);
+        memset(&old_ptr[old_size], 0, diff);
     }
 
     return old_ptr;
 }
-/// @endcond
 
-/**
- * @brief Reallocate a previously allocated chunk in the arena. With specific
- *        aligment.
- *
- * @param[in] self              Arena pointer.
- * @param[in] old_ptr_          Pointer to the buffer to reallocate
- * @param[in] alignment         Alignment size.
- * @param[in] old_size          Old size.
- * @param[in] new_size          New size to grow/shrink to.
- *
- * @return                      A pointer to the reallocated memory chunk.
- * @retval NULL                 If arena doesn't have enough memory for the reallocation or invalid parameters are
- *                              given.
- */
-static inline void *arena_reallocate_aligned(struct arena *self, void *old_ptr_, const size_t alignment,
-                                             const size_t old_size, const size_t new_size)
+static inline void *internal_arena_reallocate_aligned(struct arena *self, void *old_ptr_, const size_t alignment,
+                                                      const size_t old_size, const size_t new_size, const bool zero)
 {
-    assert(self);
     assert(is_pow2(alignment));
 
     unsigned char *old_ptr = (unsigned char *)old_ptr_;
@@ -182,19 +455,73 @@ static inline void *arena_reallocate_aligned(struct arena *self, void *old_ptr_,
     }
 
     const bool has_optimized_w_prev_buf =
-        internal_arena_try_optimizing_w_prev_offset(self, old_ptr, old_size, new_size);
+        internal_arena_try_optimizing_w_prev_offset(self, old_ptr, old_size, new_size, zero);
     if (has_optimized_w_prev_buf) {
         return old_ptr;
     }
 
     const size_t copy_size = old_size < new_size ? old_size : new_size;
 
-    void *new_mem = arena_allocate_aligned(self, alignment, new_size);
+    unsigned char *new_mem = (unsigned char *)internal_arena_allocate_aligned(self, alignment, new_size, false);
+
+    if (!new_mem) {
+        return NULL;
+    }
 
     memmove(new_mem, old_ptr, copy_size);
 
+    if (zero && new_size > copy_size) {
+        memset(&new_mem[copy_size], 0, new_size - copy_size);
+    }
+
     return new_mem;
 }
+/// @endcond
+
+/**
+ * @brief Reallocate a previously allocated chunk in the arena. With specific
+ *        aligment.
+ *
+ * @param[in] self              Arena pointer.
+ * @param[in] old_ptr_          Pointer to the buffer to reallocate
+ * @param[in] alignment         Alignment size.
+ * @param[in] old_size          Old size.
+ * @param[in] new_size          New size to grow/shrink to.
+ *
+ * @return                      A pointer to the reallocated memory chunk. The grown part is zeroed out
+ *                              (uninitialized if `ARENA_ZERO_MEMORY` is 0).
+ * @retval NULL                 If arena doesn't have enough memory for the reallocation or invalid parameters are
+ *                              given.
+ */
+static inline void *arena_reallocate_aligned(struct arena *self, void *old_ptr_, const size_t alignment,
+                                             const size_t old_size, const size_t new_size)
+{
+    assert(self);
+
+    return internal_arena_reallocate_aligned(self, old_ptr_, alignment, old_size, new_size, ARENA_ZERO_MEMORY);
+}
+
+/**
+ * @brief Reallocate a previously allocated chunk in the arena, leaving the
+ *        grown part uninitialized. With specific aligment.
+ *
+ * @param[in] self              Arena pointer.
+ * @param[in] old_ptr_          Pointer to the buffer to reallocate
+ * @param[in] alignment         Alignment size.
+ * @param[in] old_size          Old size.
+ * @param[in] new_size          New size to grow/shrink to.
+ *
+ * @return                      A pointer to the reallocated memory chunk.
+ * @retval NULL                 If arena doesn't have enough memory for the reallocation or invalid parameters are
+ *                              given.
+ */
+static inline void *arena_reallocate_aligned_uninit(struct arena *self, void *old_ptr_, const size_t alignment,
+                                                    const size_t old_size, const size_t new_size)
+{
+    assert(self);
+
+    return internal_arena_reallocate_aligned(self, old_ptr_, alignment, old_size, new_size, false);
+}
 
 /**
  * @brief Reallocate a previously allocated chunk in the arena.
@@ -204,7 +531,8 @@ static inline void *arena_reallocate_aligned(struct arena *self, void *old_ptr_,
  * @param[in] old_size          Old size.
  * @param[in] new_size          New size to grow/shrink to.
  *
- * @return                      A pointer to the reallocated memory chunk.
+ * @return                      A pointer to the reallocated memory chunk. The grown part is zeroed out
+ *                              (uninitialized if `ARENA_ZERO_MEMORY` is 0).
  * @retval NULL                 If arena doesn't have enough memory for the reallocation or invalid parameters are
  *                              given.
  */
@@ -215,6 +543,27 @@ static inline void *arena_reallocate(struct arena *self, void *old_ptr, const si
     return arena_reallocate_aligned(self, old_ptr, alignof(max_align_t), old_size, new_size);
 }
 
+/**
+ * @brief Reallocate a previously allocated chunk in the arena, leaving the
+ *        grown part uninitialized.
+ *
+ * @param[in] self              The arena pointer.
+ * @param[in] old_ptr           Pointer to the buffer to reallocate
+ * @param[in] old_size          Old size.
+ * @param[in] new_size          New size to grow/shrink to.
+ *
+ * @return                      A pointer to the reallocated memory chunk.
+ * @retval NULL                 If arena doesn't have enough memory for the reallocation or invalid parameters are
+ *                              given.
+ */
+static inline void *arena_reallocate_uninit(struct arena *self, void *old_ptr, const size_t old_size,
+                                            const size_t new_size)
+{
+    assert(self);
+
+    return arena_reallocate_aligned_uninit(self, old_ptr, alignof(max_align_t), old_size, new_size);
+}
+
 /**
  * @brief Save the arena state temporarily.
  *
@@ -239,3 +588,39 @@ static inline void temp_arena_state_restore(struct temp_arena_state prev_state)
     prev_state.arena_ptr->prev_offset = prev_state.prev_offset;
     prev_state.arena_ptr->curr_offset = prev_state.curr_offset;
 }
+
+#ifdef ARENA_STATS
+/**
+ * @brief Get the usage statistics of the arena. Only available if
+ *        `ARENA_STATS` is defined.
+ *
+ * The statistics are kept by `arena_deallocate_all` and
+ * `temp_arena_state_restore`, such that the high-water mark covers the
+ * lifetime of the arena.
+ *
+ * @param[in] self              The arena pointer.
+ *
+ * @return                      The usage statistics since `arena_init` or the last `arena_reset_stats`.
+ */
+static inline struct arena_stats arena_get_stats(const struct arena *self)
+{
+    assert(self);
+
+    return self->stats;
+}
+
+/**
+ * @brief Reset the usage statistics of the arena. The high-water mark is set
+ *        to the current offset. Only available if `ARENA_STATS` is defined.
+ *
+ * @param[in] self              The arena pointer.
+ */
+static inline void arena_reset_stats(struct arena *self)
+{
+    assert(self);
+
+    internal_arena_stats_reset(self);
+
+    self->stats.high_water_mark = self->curr_offset;
+}
+#endif
@@ -0,0 +1,517 @@
+/*  deque.h
+ *
+ *  Copyright (C) 2023 abxh
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *  See the file LICENSE included with this distribution for more
+ *  information. */
+
+/**
+ * @file deque.h
+ * @brief Growable double-ended queue based on ring buffer
+ *
+ * Uses the same power-of-2 ring indexing as `fqueue.h`, but the values are kept
+ * in a separate buffer, which is doubled in size when the deque is full. The
+ * wrapped ring is unrolled into the new buffer, such that the front is placed
+ * at index 0.
+ *
+ * The following macros must be defined:
+ *      @li `NAME`
+ *      @li `VALUE_TYPE`
+ */
+
+// macro definitions: {{{
+
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include "is_pow2.h"       // is_pow2
+#include "paste.h"         // PASTE, XPASTE, JOIN
+#include "round_up_pow2.h" // round_up_pow2_32
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @def deque_for_each(self, index, value)
+ * @brief Iterate over the values in the deque from the front to back.
+ *
+ * @warning Modifying the deque under the iteration may result in errors.
+ *
+ * @param[in] self              Deque pointer.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t`.
+ * @param[out] value            Current value. Should be `VALUE_TYPE`.
+ */
+#define deque_for_each(self, index, value)                                                                           \
+    for ((index) = 0; (index) < (self)->count                                                                        \
+                      && ((value) = (self)->values[((self)->begin_index + (index)) & ((self)->capacity - 1)], true); \
+         (index)++)
+
+/**
+ * @def deque_for_each_reverse(self, index, value)
+ * @brief Iterate over the values in the deque from the back to front.
+ *
+ * @warning Modifying the deque under the iteration may result in errors.
+ *
+ * @param[in] self              Deque pointer.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t`.
+ * @param[out] value            Current value. Should be `VALUE_TYPE`.
+ */
+#define deque_for_each_reverse(self, index, value)                                                                     \
+    for ((index) = 0; (index) < (self)->count                                                                          \
+                      && ((value) = (self)->values[((self)->end_index - 1 - (index)) & ((self)->capacity - 1)], true); \
+         (index)++)
+
+#endif // DEQUE_H
+
+/**
+ * @def NAME
+ * @brief Prefix to deque type and operations. This must be manually defined
+ *        before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef NAME
+#define NAME deque
+#error "Must define NAME."
+#else
+#define DEQUE_NAME NAME
+#endif
+
+/**
+ * @def VALUE_TYPE
+ * @brief Deque value type. This must be manually defined before including this
+ *        header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef VALUE_TYPE
+#define VALUE_TYPE int
+#error "Must define VALUE_TYPE."
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#define DEQUE_TYPE     struct DEQUE_NAME
+#define DEQUE_IS_EMPTY JOIN(DEQUE_NAME, is_empty)
+#define DEQUE_IS_FULL  JOIN(DEQUE_NAME, is_full)
+#define DEQUE_RESERVE  JOIN(DEQUE_NAME, reserve)
+#define DEQUE_GROW     JOIN(internal, JOIN(DEQUE_NAME, grow))
+/// @endcond
+
+// }}}
+
+// type definitions: {{{
+
+/**
+ * @brief Generated deque struct type for a `VALUE_TYPE`.
+ */
+struct DEQUE_NAME {
+    uint32_t begin_index; ///< Index used to track the front of the deque.
+    uint32_t end_index;   ///< Index used to track the back of the deque.
+    uint32_t count;       ///< Number of values.
+    uint32_t capacity;    ///< Number of values allocated for.
+    VALUE_TYPE *values;   ///< Pointer to array of values.
+};
+
+// }}}
+
+// function definitions: {{{
+
+/**
+ * @brief Create a deque struct with a given initial capacity with malloc().
+ *
+ * @param[in] min_capacity      Number of elements expected to be stored initially.
+ *
+ * @return                      A pointer to the deque.
+ * @retval NULL
+ *   @li                        If malloc fails.
+ *   @li                        If capacity is 0 or larger than UINT32_MAX / 2 + 1.
+ */
+static inline DEQUE_TYPE *JOIN(DEQUE_NAME, create)(const uint32_t min_capacity)
+{
+    if (min_capacity == 0 || min_capacity > UINT32_MAX / 2 + 1) {
+        return NULL;
+    }
+
+    const uint32_t capacity = round_up_pow2_32(min_capacity);
+
+    DEQUE_TYPE *self = (DEQUE_TYPE *)calloc(1, sizeof(DEQUE_TYPE));
+
+    if (!self) {
+        return NULL;
+    }
+
+    self->values = (VALUE_TYPE *)malloc(capacity * sizeof(VALUE_TYPE));
+
+    if (!self->values) {
+        free(self);
+        return NULL;
+    }
+
+    self->begin_index = self->end_index = 0;
+    self->count = 0;
+    self->capacity = capacity;
+
+    return self;
+}
+
+/**
+ * @brief Destroy a deque struct and free the underlying memory with free().
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The deque pointer.
+ */
+static inline void JOIN(DEQUE_NAME, destroy)(DEQUE_TYPE *self)
+{
+    assert(self != NULL);
+
+    free(self->values);
+    free(self);
+}
+
+/**
+ * @brief Return whether the deque is empty.
+ *
+ * @param[in] self              The deque pointer.
+ *
+ * @return                      Whether the deque is empty.
+ */
+static inline bool JOIN(DEQUE_NAME, is_empty)(const DEQUE_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == 0;
+}
+
+/**
+ * @brief Return whether the deque is full, i.e. whether the next push will
+ *        grow the underlying buffer.
+ *
+ * @param[in] self              The deque pointer.
+ *
+ * @return                      Whether the deque is full.
+ */
+static inline bool JOIN(DEQUE_NAME, is_full)(const DEQUE_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == self->capacity;
+}
+
+/**
+ * @brief Grow the deque, such that it can hold at least a given number of
+ *        values without reallocating.
+ *
+ * The values are unrolled into the new buffer with (at most) two memcpy()
+ * calls, such that the front is placed at index 0.
+ *
+ * @param[in] self              The deque pointer.
+ * @param[in] min_capacity      Minimum capacity.
+ *
+ * @return                      Whether the deque can hold `min_capacity` values.
+ * @retval false
+ *   @li                        If malloc fails.
+ *   @li                        If capacity is larger than UINT32_MAX / 2 + 1.
+ */
+static inline bool JOIN(DEQUE_NAME, reserve)(DEQUE_TYPE *self, const uint32_t min_capacity)
+{
+    assert(self != NULL);
+
+    if (min_capacity <= self->capacity) {
+        return true;
+    }
+    if (min_capacity > UINT32_MAX / 2 + 1) {
+        return false;
+    }
+
+    const uint32_t capacity = round_up_pow2_32(min_capacity);
+
+    VALUE_TYPE *values = (VALUE_TYPE *)malloc(capacity * sizeof(VALUE_TYPE));
+
+    if (!values) {
+        return false;
+    }
+
+    const uint32_t first_part = self->capacity - self->begin_index;
+
+    if (self->count <= first_part) {
+        memcpy(&values[0], &self->values[self->begin_index], self->count * sizeof(VALUE_TYPE));
+    }
+    else {
+        memcpy(&values[0], &self->values[self->begin_index], first_part * sizeof(VALUE_TYPE));
+        memcpy(&values[first_part], &self->values[0], (self->count - first_part) * sizeof(VALUE_TYPE));
+    }
+
+    free(self->values);
+
+    self->values = values;
+    self->capacity = capacity;
+    self->begin_index = 0;
+    self->end_index = self->count & (capacity - 1);
+
+    return true;
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline bool JOIN(internal, JOIN(DEQUE_NAME, grow))(DEQUE_TYPE *self)
+{
+    if (self->capacity > UINT32_MAX / 2) {
+        return false;
+    }
+    return DEQUE_RESERVE(self, 2 * self->capacity);
+}
+/// @endcond
+
+/**
+ * @brief Get the value at index.
+ *
+ * @note Index starts from the front as `0` and is counted upward to `count - 1`
+ *       as back.
+ *
+ * @param[in] self              The deque pointer.
+ * @param[in] index             The index to retrieve to value from.
+ *
+ * @return                      The value at `index`.
+ */
+static inline VALUE_TYPE JOIN(DEQUE_NAME, at)(const DEQUE_TYPE *self, const uint32_t index)
+{
+    assert(self != NULL);
+    assert(index < self->count);
+
+    const uint32_t index_mask = (self->capacity - 1);
+
+    return self->values[(self->begin_index + index) & index_mask];
+}
+
+/**
+ * @brief Get the value from the front of a non-empty deque.
+ *
+ * @param[in] self              The deque pointer.
+ *
+ * @return                      The front value.
+ */
+static inline VALUE_TYPE JOIN(DEQUE_NAME, get_front)(const DEQUE_TYPE *self)
+{
+    assert(self != NULL);
+    assert(!DEQUE_IS_EMPTY(self));
+
+    return self->values[self->begin_index];
+}
+
+/**
+ * @brief Get the value from the back of a non-empty deque.
+ *
+ * @param[in] self              The deque pointer.
+ *
+ * @return                      The back value.
+ */
+static inline VALUE_TYPE JOIN(DEQUE_NAME, get_back)(const DEQUE_TYPE *self)
+{
+    assert(self != NULL);
+    assert(!DEQUE_IS_EMPTY(self));
+
+    const uint32_t index_mask = (self->capacity - 1);
+
+    return self->values[(self->end_index - 1) & index_mask];
+}
+
+/**
+ * @brief Push a value at the back of the deque. Grows the deque if it is full.
+ *
+ * @param[in] self              The deque pointer.
+ * @param[in] value             The value to push.
+ *
+ * @return                      Whether the value was pushed.
+ * @retval false                If the deque was full and growing it failed.
+ */
+static inline bool JOIN(DEQUE_NAME, push_back)(DEQUE_TYPE *self, VALUE_TYPE const value)
+{
+    assert(self != NULL);
+
+    if (DEQUE_IS_FULL(self) && !DEQUE_GROW(self)) {
+        return false;
+    }
+
+    const uint32_t index_mask = (self->capacity - 1);
+
+    self->values[self->end_index] = value;
+    self->end_index++;
+    self->end_index &= index_mask;
+    self->count++;
+
+    return true;
+}
+
+/**
+ * @brief Push a value at the front of the deque. Grows the deque if it is
+ *        full.
+ *
+ * @param[in] self              The deque pointer.
+ * @param[in] value             The value to push.
+ *
+ * @return                      Whether the value was pushed.
+ * @retval false                If the deque was full and growing it failed.
+ */
+static inline bool JOIN(DEQUE_NAME, push_front)(DEQUE_TYPE *self, VALUE_TYPE const value)
+{
+    assert(self != NULL);
+
+    if (DEQUE_IS_FULL(self) && !DEQUE_GROW(self)) {
+        return false;
+    }
+
+    const uint32_t index_mask = (self->capacity - 1);
+
+    self->begin_index--;
+    self->begin_index &= index_mask;
+    self->values[self->begin_index] = value;
+    self->count++;
+
+    return true;
+}
+
+/**
+ * @brief Pop a value from the front of a non-empty deque.
+ *
+ * @param[in] self              The deque pointer.
+ *
+ * @return                      The front value.
+ */
+static inline VALUE_TYPE JOIN(DEQUE_NAME, pop_front)(DEQUE_TYPE *self)
+{
+    assert(self != NULL);
+    assert(!DEQUE_IS_EMPTY(self));
+
+    const uint32_t index_mask = (self->capacity - 1);
+
+    VALUE_TYPE const value = self->values[self->begin_index];
+    self->begin_index++;
+    self->begin_index &= index_mask;
+    self->count--;
+
+    return value;
+}
+
+/**
+ * @brief Pop a value from the back of a non-empty deque.
+ *
+ * @param[in] self              The deque pointer.
+ *
+ * @return                      The back value.
+ */
+static inline VALUE_TYPE JOIN(DEQUE_NAME, pop_back)(DEQUE_TYPE *self)
+{
+    assert(self != NULL);
+    assert(!DEQUE_IS_EMPTY(self));
+
+    const uint32_t index_mask = (self->capacity - 1);
+
+    self->end_index--;
+    self->end_index &= index_mask;
+    self->count--;
+
+    return self->values[self->end_index];
+}
+
+/**
+ * @brief Enqueue a value at the back of the deque. Same as `push_back`.
+ *
+ * @param[in] self              The deque pointer.
+ * @param[in] value             The value to enqueue.
+ *
+ * @return                      Whether the value was enqueued.
+ */
+static inline bool JOIN(DEQUE_NAME, enqueue)(DEQUE_TYPE *self, VALUE_TYPE const value)
+{
+    return JOIN(DEQUE_NAME, push_back)(self, value);
+}
+
+/**
+ * @brief Dequeue a value from the front of a non-empty deque. Same as
+ *        `pop_front`.
+ *
+ * @param[in] self              The deque pointer.
+ *
+ * @return                      The front value.
+ */
+static inline VALUE_TYPE JOIN(DEQUE_NAME, dequeue)(DEQUE_TYPE *self)
+{
+    return JOIN(DEQUE_NAME, pop_front)(self);
+}
+
+/**
+ * @brief Clear the elements in the deque. The capacity is kept.
+ *
+ * @param[in] self              The deque pointer.
+ */
+static inline void JOIN(DEQUE_NAME, clear)(DEQUE_TYPE *self)
+{
+    assert(self != NULL);
+
+    self->count = 0;
+    self->begin_index = self->end_index = 0;
+}
+
+/**
+ * @brief Copy the values from a source deque to a destination deque. The
+ *        destination is grown if needed.
+ *
+ * @param[in,out] dest_ptr      The destination deque.
+ * @param[in] src_ptr           The source deque.
+ *
+ * @return                      Whether the values were copied.
+ * @retval false                If growing the destination failed.
+ */
+static inline bool JOIN(DEQUE_NAME, copy)(DEQUE_TYPE *restrict dest_ptr, const DEQUE_TYPE *restrict src_ptr)
+{
+    assert(src_ptr != NULL);
+    assert(dest_ptr != NULL);
+    assert(DEQUE_IS_EMPTY(dest_ptr));
+
+    if (!DEQUE_RESERVE(dest_ptr, src_ptr->count)) {
+        return false;
+    }
+
+    const uint32_t first_part = src_ptr->capacity - src_ptr->begin_index;
+
+    if (src_ptr->count <= first_part) {
+        memcpy(&dest_ptr->values[0], &src_ptr->values[src_ptr->begin_index], src_ptr->count * sizeof(VALUE_TYPE));
+    }
+    else {
+        memcpy(&dest_ptr->values[0], &src_ptr->values[src_ptr->begin_index], first_part * sizeof(VALUE_TYPE));
+        memcpy(&dest_ptr->values[first_part], &src_ptr->values[0],
+               (src_ptr->count - first_part) * sizeof(VALUE_TYPE));
+    }
+
+    dest_ptr->count = src_ptr->count;
+    dest_ptr->begin_index = 0;
+    dest_ptr->end_index = src_ptr->count & (dest_ptr->capacity - 1);
+
+    return true;
+}
+
+// }}}
+
+// macro undefs: {{{
+
+#undef NAME
+#undef VALUE_TYPE
+
+#undef DEQUE_NAME
+#undef DEQUE_TYPE
+#undef DEQUE_IS_EMPTY
+#undef DEQUE_IS_FULL
+#undef DEQUE_RESERVE
+#undef DEQUE_GROW
+
+// }}}
+
+// vim: ft=c fdm=marker
@@ -0,0 +1,611 @@
+/*  fbqueue.h
+ *
+ *  Copyright (C) 2023 abxh
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *  See the file LICENSE included with this distribution for more
+ *  information. */
+
+/**
+ * @file fbqueue.h
+ * @brief Fixed-size blocking queue based on ring buffer
+ *
+ * A thread-safe variant of `fqueue.h` for multiple producers and consumers.
+ * Every slot in the ring buffer carries a sequence number, such that
+ * `try_enqueue` / `try_dequeue` are lock-free. `enqueue_wait` / `dequeue_wait`
+ * only park the calling thread when the queue is full / empty. Threads are
+ * parked using Linux futexes, or C11 condition variables elsewhere. A waking
+ * system call is only made when a thread is parked.
+ *
+ * The following macros must be defined:
+ *      @li `NAME`
+ *      @li `VALUE_TYPE`
+ *
+ * Sources used:
+ * @li https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ * @li https://man7.org/linux/man-pages/man2/futex.2.html
+ */
+
+// macro definitions: {{{
+
+#ifndef FBQUEUE_H
+#define FBQUEUE_H
+
+#include "align.h"         // calc_alignment_padding
+#include "is_pow2.h"       // is_pow2
+#include "paste.h"         // PASTE, XPASTE, JOIN
+#include "round_up_pow2.h" // round_up_pow2_32
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <threads.h>
+#endif
+
+/**
+ * @def FBQUEUE_WAIT_FOREVER
+ * @brief Timeout value used to wait without a timeout.
+ */
+#define FBQUEUE_WAIT_FOREVER (UINT64_MAX)
+
+/**
+ * @def fbqueue_calc_sizeof(fbqueue_name, capacity)
+ *
+ * @brief Calculate the size of the queue struct. No overflow checks.
+ *
+ * @param[in] fbqueue_name      Defined queue NAME.
+ * @param[in] capacity          Capacity input.
+ *
+ * @return                      The equivalent size.
+ */
+#define fbqueue_calc_sizeof(fbqueue_name, capacity) \
+    (uint32_t)(offsetof(struct fbqueue_name, slots) + capacity * sizeof(((struct fbqueue_name *)0)->slots[0]))
+
+/**
+ * @def fbqueue_calc_sizeof_overflows(fbqueue_name, capacity)
+ *
+ * @brief Check for a given capacity, if the equivalent size of the queue struct overflows.
+ *
+ * @param[in] fbqueue_name      Defined queue NAME.
+ * @param[in] capacity          Capacity input.
+ *
+ * @return                      Whether the equivalent size overflows.
+ */
+#define fbqueue_calc_sizeof_overflows(fbqueue_name, capacity) \
+    (capacity > (UINT32_MAX - offsetof(struct fbqueue_name, slots)) / sizeof(((struct fbqueue_name *)0)->slots[0]))
+
+/**
+ * @brief Event used to park and wake threads.
+ *
+ * The sequence number is incremented on every notification with parked
+ * threads, and is used as the futex word.
+ */
+struct fbqueue_event {
+    _Atomic uint32_t seq;     ///< Notification sequence number.
+    _Atomic uint32_t waiters; ///< Number of parked (or about to be parked) threads.
+#ifndef __linux__
+    mtx_t mtx; ///< Mutex used with the condition variable.
+    cnd_t cnd; ///< Condition variable used to park threads.
+#endif
+};
+
+/// @cond DO_NOT_DOCUMENT
+static inline void internal_fbqueue_event_init(struct fbqueue_event *event)
+{
+    atomic_init(&event->seq, 0);
+    atomic_init(&event->waiters, 0);
+#ifndef __linux__
+    mtx_init(&event->mtx, mtx_plain);
+    cnd_init(&event->cnd);
+#endif
+}
+
+static inline void internal_fbqueue_event_deinit(struct fbqueue_event *event)
+{
+#ifndef __linux__
+    cnd_destroy(&event->cnd);
+    mtx_destroy(&event->mtx);
+#else
+    (void)(event);
+#endif
+}
+
+/* compute the absolute deadline (CLOCK_MONOTONIC on linux, TIME_UTC otherwise) */
+static inline struct timespec internal_fbqueue_deadline(const uint64_t timeout_ns)
+{
+    struct timespec ts;
+#ifdef __linux__
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+    timespec_get(&ts, TIME_UTC);
+#endif
+    const uint64_t nsec = (uint64_t)ts.tv_nsec + timeout_ns % 1000000000U;
+    ts.tv_sec += (time_t)(timeout_ns / 1000000000U + nsec / 1000000000U);
+    ts.tv_nsec = (long)(nsec % 1000000000U);
+    return ts;
+}
+
+/* wait until the event sequence number differs from seq, or the deadline has passed (if given) */
+static inline void internal_fbqueue_event_wait(struct fbqueue_event *event, const uint32_t seq,
+                                               const struct timespec *deadline)
+{
+#ifdef __linux__
+    struct timespec rel;
+    if (deadline) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+
+        rel.tv_sec = deadline->tv_sec - now.tv_sec;
+        rel.tv_nsec = deadline->tv_nsec - now.tv_nsec;
+        if (rel.tv_nsec < 0) {
+            rel.tv_sec--;
+            rel.tv_nsec += 1000000000L;
+        }
+        if (rel.tv_sec < 0) {
+            return;
+        }
+    }
+    syscall(SYS_futex, &event->seq, FUTEX_WAIT_PRIVATE, seq, deadline ? &rel : NULL, NULL, 0);
+#else
+    mtx_lock(&event->mtx);
+    while (atomic_load(&event->seq) == seq) {
+        const int res =
+            deadline ? cnd_timedwait(&event->cnd, &event->mtx, deadline) : cnd_wait(&event->cnd, &event->mtx);
+        if (res != thrd_success) {
+            break;
+        }
+    }
+    mtx_unlock(&event->mtx);
+#endif
+}
+
+/* wake all parked threads. nothing is written to shared memory if no threads are parked */
+static inline void internal_fbqueue_event_notify(struct fbqueue_event *event)
+{
+    /* pairs with the waiters increment before the final retry in the waiting thread */
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if (atomic_load_explicit(&event->waiters, memory_order_relaxed) == 0) {
+        return;
+    }
+
+    atomic_fetch_add(&event->seq, 1);
+
+#ifdef __linux__
+    syscall(SYS_futex, &event->seq, FUTEX_WAKE_PRIVATE, INT32_MAX, NULL, NULL, 0);
+#else
+    mtx_lock(&event->mtx);
+    cnd_broadcast(&event->cnd);
+    mtx_unlock(&event->mtx);
+#endif
+}
+
+static inline bool internal_fbqueue_deadline_passed(const struct timespec *deadline)
+{
+    struct timespec now;
+#ifdef __linux__
+    clock_gettime(CLOCK_MONOTONIC, &now);
+#else
+    timespec_get(&now, TIME_UTC);
+#endif
+    return now.tv_sec > deadline->tv_sec || (now.tv_sec == deadline->tv_sec && now.tv_nsec >= deadline->tv_nsec);
+}
+/// @endcond
+
+#endif // FBQUEUE_H
+
+/**
+ * @def NAME
+ * @brief Prefix to queue type and operations. This must be manually defined
+ *        before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef NAME
+#define NAME fbqueue
+#error "Must define NAME."
+#else
+#define FBQUEUE_NAME NAME
+#endif
+
+/**
+ * @def VALUE_TYPE
+ * @brief Queue value type. This must be manually defined before including this
+ *        header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef VALUE_TYPE
+#define VALUE_TYPE int
+#error "Must define VALUE_TYPE."
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#define FBQUEUE_TYPE        struct FBQUEUE_NAME
+#define FBQUEUE_SLOT_TYPE   struct JOIN(FBQUEUE_NAME, slot)
+#define FBQUEUE_INIT        JOIN(FBQUEUE_NAME, init)
+#define FBQUEUE_TRY_ENQUEUE JOIN(FBQUEUE_NAME, try_enqueue)
+#define FBQUEUE_TRY_DEQUEUE JOIN(FBQUEUE_NAME, try_dequeue)
+/// @endcond
+
+// }}}
+
+// type definitions: {{{
+
+/**
+ * @brief Generated queue slot struct type for a `VALUE_TYPE`.
+ */
+struct JOIN(FBQUEUE_NAME, slot) {
+    _Atomic uint32_t seq; ///< Slot sequence number. Tells whether the slot is ready to be written to or read from.
+    VALUE_TYPE value;     ///< Slot value.
+};
+
+/**
+ * @brief Generated queue struct type for a `VALUE_TYPE`.
+ */
+struct FBQUEUE_NAME {
+    uint32_t capacity;                               ///< Maximum number of values allocated for.
+    alignas(64) _Atomic uint32_t end_index;          ///< Index used to track the back of the queue.
+    alignas(64) _Atomic uint32_t begin_index;        ///< Index used to track the front of the queue.
+    alignas(64) struct fbqueue_event not_empty_event; ///< Event waited on by consumers.
+    alignas(64) struct fbqueue_event not_full_event;  ///< Event waited on by producers.
+    alignas(64) FBQUEUE_SLOT_TYPE slots[];            ///< Array of slots.
+};
+
+// }}}
+
+// function definitions: {{{
+
+/**
+ * @brief Initialize a queue struct, given a (power-of-2) capacity.
+ *
+ * @note The slot sequence numbers require a capacity of at least 2.
+ *
+ * @param[in] self              Queue pointer
+ * @param[in] pow2_capacity     Power of 2 capacity
+ */
+static inline FBQUEUE_TYPE *JOIN(FBQUEUE_NAME, init)(FBQUEUE_TYPE *self, const uint32_t pow2_capacity)
+{
+    assert(self);
+    assert(is_pow2(pow2_capacity));
+    assert(pow2_capacity >= 2);
+
+    self->capacity = pow2_capacity;
+    atomic_init(&self->begin_index, 0);
+    atomic_init(&self->end_index, 0);
+
+    for (uint32_t i = 0; i < pow2_capacity; i++) {
+        atomic_init(&self->slots[i].seq, i);
+    }
+
+    internal_fbqueue_event_init(&self->not_empty_event);
+    internal_fbqueue_event_init(&self->not_full_event);
+
+    return self;
+}
+
+/**
+ * @brief Create an queue struct with a given capacity with aligned_alloc().
+ *
+ * @param[in] min_capacity      Maximum number of elements expected to be stored. Rounded up to at least 2.
+ *
+ * @return                      A pointer to the queue.
+ * @retval NULL
+ *   @li                        If aligned_alloc fails.
+ *   @li                        If capacity is 0 or larger than UINT32_MAX / 4 + 1 or the equivalent size overflows.
+ */
+static inline FBQUEUE_TYPE *JOIN(FBQUEUE_NAME, create)(const uint32_t min_capacity)
+{
+    if (min_capacity == 0 || min_capacity > UINT32_MAX / 4 + 1) {
+        return NULL;
+    }
+
+    const uint32_t capacity = min_capacity < 2 ? 2 : round_up_pow2_32(min_capacity);
+
+    if (fbqueue_calc_sizeof_overflows(FBQUEUE_NAME, capacity)) {
+        return NULL;
+    }
+
+    uint32_t size = fbqueue_calc_sizeof(FBQUEUE_NAME, capacity);
+
+    size += (uint32_t)calc_alignment_padding(alignof(FBQUEUE_TYPE), size);
+
+    FBQUEUE_TYPE *self = (FBQUEUE_TYPE *)aligned_alloc(alignof(FBQUEUE_TYPE), size);
+
+    if (!self) {
+        return NULL;
+    }
+
+    FBQUEUE_INIT(self, capacity);
+
+    return self;
+}
+
+/**
+ * @brief Destroy an queue struct and free the underlying memory with free().
+ *
+ * @warning May not be called twice in a row on the same object. Or while other
+ *          threads are using the queue.
+ *
+ * @param[in] self              The queue pointer.
+ */
+static inline void JOIN(FBQUEUE_NAME, destroy)(FBQUEUE_TYPE *self)
+{
+    assert(self != NULL);
+
+    internal_fbqueue_event_deinit(&self->not_empty_event);
+    internal_fbqueue_event_deinit(&self->not_full_event);
+
+    free(self);
+}
+
+/**
+ * @brief Return the number of values in the queue.
+ *
+ * @note The count is only a snapshot, when other threads are using the queue.
+ *
+ * @param[in] self              The queue pointer.
+ *
+ * @return                      The number of values.
+ */
+static inline uint32_t JOIN(FBQUEUE_NAME, count)(FBQUEUE_TYPE *self)
+{
+    assert(self != NULL);
+
+    const uint32_t begin_index = atomic_load_explicit(&self->begin_index, memory_order_relaxed);
+    const uint32_t end_index = atomic_load_explicit(&self->end_index, memory_order_relaxed);
+    const uint32_t count = end_index - begin_index;
+
+    return (int32_t)count < 0 ? 0 : count > self->capacity ? self->capacity : count;
+}
+
+/**
+ * @brief Try to enqueue a value at the back of the queue, without blocking.
+ *
+ * @param[in] self              The queue pointer.
+ * @param[in] value             The value to enqueue.
+ *
+ * @return                      Whether the value was enqueued.
+ * @retval false                If the queue was full.
+ */
+static inline bool JOIN(FBQUEUE_NAME, try_enqueue)(FBQUEUE_TYPE *self, VALUE_TYPE const value)
+{
+    assert(self != NULL);
+
+    const uint32_t index_mask = self->capacity - 1;
+
+    FBQUEUE_SLOT_TYPE *slot;
+    uint32_t end_index = atomic_load_explicit(&self->end_index, memory_order_relaxed);
+
+    while (true) {
+        slot = &self->slots[end_index & index_mask];
+
+        const uint32_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        const int32_t diff = (int32_t)(seq - end_index);
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&self->end_index, &end_index, end_index + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            return false;
+        }
+        else {
+            end_index = atomic_load_explicit(&self->end_index, memory_order_relaxed);
+        }
+    }
+
+    slot->value = value;
+    atomic_store_explicit(&slot->seq, end_index + 1, memory_order_release);
+
+    internal_fbqueue_event_notify(&self->not_empty_event);
+
+    return true;
+}
+
+/**
+ * @brief Try to dequeue a value from the front of the queue, without blocking.
+ *
+ * @param[in] self              The queue pointer.
+ * @param[out] value_ptr        Pointer to store the front value in.
+ *
+ * @return                      Whether a value was dequeued.
+ * @retval false                If the queue was empty.
+ */
+static inline bool JOIN(FBQUEUE_NAME, try_dequeue)(FBQUEUE_TYPE *self, VALUE_TYPE *value_ptr)
+{
+    assert(self != NULL);
+    assert(value_ptr != NULL);
+
+    const uint32_t index_mask = self->capacity - 1;
+
+    FBQUEUE_SLOT_TYPE *slot;
+    uint32_t begin_index = atomic_load_explicit(&self->begin_index, memory_order_relaxed);
+
+    while (true) {
+        slot = &self->slots[begin_index & index_mask];
+
+        const uint32_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        const int32_t diff = (int32_t)(seq - (begin_index + 1));
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&self->begin_index, &begin_index, begin_index + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            return false;
+        }
+        else {
+            begin_index = atomic_load_explicit(&self->begin_index, memory_order_relaxed);
+        }
+    }
+
+    *value_ptr = slot->value;
+    atomic_store_explicit(&slot->seq, begin_index + self->capacity, memory_order_release);
+
+    internal_fbqueue_event_notify(&self->not_full_event);
+
+    return true;
+}
+
+/**
+ * @brief Enqueue a value at the back of the queue. Block while the queue is
+ *        full, up to a given timeout.
+ *
+ * @param[in] self              The queue pointer.
+ * @param[in] value             The value to enqueue.
+ * @param[in] timeout_ns        Timeout in nanoseconds. `FBQUEUE_WAIT_FOREVER` to wait without a timeout.
+ *
+ * @return                      Whether the value was enqueued.
+ * @retval false                If the timeout passed.
+ */
+static inline bool JOIN(FBQUEUE_NAME, enqueue_wait)(FBQUEUE_TYPE *self, VALUE_TYPE const value,
+                                                    const uint64_t timeout_ns)
+{
+    assert(self != NULL);
+
+    if (FBQUEUE_TRY_ENQUEUE(self, value)) {
+        return true;
+    }
+
+    const bool has_deadline = timeout_ns != FBQUEUE_WAIT_FOREVER;
+    const struct timespec deadline = internal_fbqueue_deadline(has_deadline ? timeout_ns : 0);
+
+    struct fbqueue_event *event = &self->not_full_event;
+
+    while (true) {
+        atomic_fetch_add(&event->waiters, 1);
+
+        const uint32_t seq = atomic_load(&event->seq);
+
+        if (FBQUEUE_TRY_ENQUEUE(self, value)) {
+            atomic_fetch_sub(&event->waiters, 1);
+            return true;
+        }
+
+        internal_fbqueue_event_wait(event, seq, has_deadline ? &deadline : NULL);
+
+        atomic_fetch_sub(&event->waiters, 1);
+
+        if (FBQUEUE_TRY_ENQUEUE(self, value)) {
+            return true;
+        }
+        if (has_deadline && internal_fbqueue_deadline_passed(&deadline)) {
+            return false;
+        }
+    }
+}
+
+/**
+ * @brief Dequeue a value from the front of the queue. Block while the queue is
+ *        empty, up to a given timeout.
+ *
+ * @param[in] self              The queue pointer.
+ * @param[out] value_ptr        Pointer to store the front value in.
+ * @param[in] timeout_ns        Timeout in nanoseconds. `FBQUEUE_WAIT_FOREVER` to wait without a timeout.
+ *
+ * @return                      Whether a value was dequeued.
+ * @retval false                If the timeout passed.
+ */
+static inline bool JOIN(FBQUEUE_NAME, dequeue_wait)(FBQUEUE_TYPE *self, VALUE_TYPE *value_ptr,
+                                                    const uint64_t timeout_ns)
+{
+    assert(self != NULL);
+    assert(value_ptr != NULL);
+
+    if (FBQUEUE_TRY_DEQUEUE(self, value_ptr)) {
+        return true;
+    }
+
+    const bool has_deadline = timeout_ns != FBQUEUE_WAIT_FOREVER;
+    const struct timespec deadline = internal_fbqueue_deadline(has_deadline ? timeout_ns : 0);
+
+    struct fbqueue_event *event = &self->not_empty_event;
+
+    while (true) {
+        atomic_fetch_add(&event->waiters, 1);
+
+        const uint32_t seq = atomic_load(&event->seq);
+
+        if (FBQUEUE_TRY_DEQUEUE(self, value_ptr)) {
+            atomic_fetch_sub(&event->waiters, 1);
+            return true;
+        }
+
+        internal_fbqueue_event_wait(event, seq, has_deadline ? &deadline : NULL);
+
+        atomic_fetch_sub(&event->waiters, 1);
+
+        if (FBQUEUE_TRY_DEQUEUE(self, value_ptr)) {
+            return true;
+        }
+        if (has_deadline && internal_fbqueue_deadline_passed(&deadline)) {
+            return false;
+        }
+    }
+}
+
+/**
+ * @brief Enqueue a value at the back of the queue. Block while the queue is
+ *        full.
+ *
+ * @param[in] self              The queue pointer.
+ * @param[in] value             The value to enqueue.
+ */
+static inline void JOIN(FBQUEUE_NAME, enqueue)(FBQUEUE_TYPE *self, VALUE_TYPE const value)
+{
+    (void)JOIN(FBQUEUE_NAME, enqueue_wait)(self, value, FBQUEUE_WAIT_FOREVER);
+}
+
+/**
+ * @brief Dequeue a value from the front of the queue. Block while the queue is
+ *        empty.
+ *
+ * @param[in] self              The queue pointer.
+ *
+ * @return                      The front value.
+ */
+static inline VALUE_TYPE JOIN(FBQUEUE_NAME, dequeue)(FBQUEUE_TYPE *self)
+{
+    VALUE_TYPE value;
+
+    (void)JOIN(FBQUEUE_NAME, dequeue_wait)(self, &value, FBQUEUE_WAIT_FOREVER);
+
+    return value;
+}
+
+// }}}
+
+// macro undefs: {{{
+
+#undef NAME
+#undef VALUE_TYPE
+
+#undef FBQUEUE_NAME
+#undef FBQUEUE_TYPE
+#undef FBQUEUE_SLOT_TYPE
+#undef FBQUEUE_INIT
+#undef FBQUEUE_TRY_ENQUEUE
+#undef FBQUEUE_TRY_DEQUEUE
+
+// }}}
+
+// vim: ft=c fdm=marker
@@ -0,0 +1,625 @@
+/*  fipqueue.h
+ *
+ *  Copyright (C) 2023 abxh
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *  See the file LICENSE included with this distribution for more
+ *  information. */
+
+/**
+ * @file fipqueue.h
+ * @brief Fixed-size indexed priority queue based on binary heap.
+ *
+ * A variant of `fpqueue.h`, where every element is identified by a handle in
+ * the range `[0, capacity)`. A position map from handle to heap index is
+ * updated whenever an element is moved, such that the priority of an element
+ * can be changed (`update_priority`) or the element can be removed
+ * (`remove`) in O(log n) time.
+ *
+ * The handles are chosen by the user, e.g. as vertex indicies in Dijkstra's
+ * algorithm. Define `PRIORITY_IS_LESS` as `(a) > (b)` to pop the lowest
+ * priority first, as for distances or deadlines.
+ *
+ * The following macros must be defined:
+ *  @li `NAME`
+ *  @li `VALUE_TYPE`
+ *
+ * The following macros can be defined:
+ *  @li `PRIORITY_TYPE`
+ *  @li `PRIORITY_IS_LESS`
+ *
+ * Sources used:
+ * @li CLRS
+ * @li https://algs4.cs.princeton.edu/24pq/IndexMinPQ.java.html
+ */
+
+// macro definitions: {{{
+
+#ifndef FIPQUEUE_H
+#define FIPQUEUE_H
+
+#include "paste.h" // PASTE, XPASTE, JOIN
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * @def FIPQUEUE_NOT_QUEUED
+ * @brief Position of a handle that is not in the priority queue.
+ */
+#define FIPQUEUE_NOT_QUEUED (UINT32_MAX)
+
+/**
+ * @def fipqueue_for_each(self, index, handle_, value_)
+ * @brief Iterate over the handles and values in the priority queue in
+ *        breadth-first order.
+ *
+ * @warning Modifying the priority queue under the iteration may result in
+ *          errors.
+ *
+ * @param[in] self              Priority queue pointer.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t`.
+ * @param[out] handle_          Current handle. Should be `uint32_t`.
+ * @param[out] value_           Current value. Should be `VALUE_TYPE`.
+ */
+#define fipqueue_for_each(self, index, handle_, value_)                                                          \
+    for ((index) = 0; (index) < (self)->count && ((handle_) = (self)->elements[(index)].handle,                  \
+                                                  (value_) = (self)->elements[(index)].value, true);             \
+         (index)++)
+
+/**
+ * @def fipqueue_calc_sizeof(fipqueue_name, capacity)
+ *
+ * @brief Calculate the size of the pqueue struct, including the position map.
+ *        No overflow checks.
+ *
+ * @param[in] fipqueue_name     Defined pqueue NAME.
+ * @param[in] capacity          Capacity input.
+ *
+ * @return                      The equivalent size.
+ */
+#define fipqueue_calc_sizeof(fipqueue_name, capacity)                              \
+    (uint32_t)(offsetof(struct fipqueue_name, elements)                            \
+               + capacity * (sizeof(((struct fipqueue_name *)0)->elements[0]) + sizeof(uint32_t)))
+
+/**
+ * @def fipqueue_calc_sizeof_overflows(fipqueue_name, capacity)
+ *
+ * @brief Check for a given capacity, if the equivalent size of the pqueue struct overflows.
+ *
+ * @param[in] fipqueue_name     Defined pqueue NAME.
+ * @param[in] capacity          Capacity input.
+ *
+ * @return                      Whether the equivalent size overflows.
+ */
+#define fipqueue_calc_sizeof_overflows(fipqueue_name, capacity)         \
+    (capacity > (UINT32_MAX - offsetof(struct fipqueue_name, elements)) \
+                    / (sizeof(((struct fipqueue_name *)0)->elements[0]) + sizeof(uint32_t)))
+
+#endif // FIPQUEUE_H
+
+/**
+ * @def NAME
+ * @brief Prefix to priority queue types and operations. This must be manually
+ *        defined before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef NAME
+#define NAME fipqueue
+#error "Must define NAME."
+#else
+#define FIPQUEUE_NAME NAME
+#endif
+
+/**
+ * @def VALUE_TYPE
+ * @brief Priority queue value type. This must be manually defined before
+ *        including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef VALUE_TYPE
+#error "Must declare VALUE_TYPE."
+#define VALUE_TYPE int
+#endif
+
+/**
+ * @def PRIORITY_TYPE
+ * @brief Priority type. Defaults to `uint32_t`.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef PRIORITY_TYPE
+#define PRIORITY_TYPE uint32_t
+#endif
+
+/**
+ * @def PRIORITY_IS_LESS(a, b)
+ * @brief Used to compare two priorities. The element with a priority that is
+ *        not less than any other is popped first. Defaults to `(a) < (b)`,
+ *        which makes the heap a max-heap.
+ *
+ * Define it as `(a) > (b)` for a min-heap, or as a function call for
+ * composite priorities.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef PRIORITY_IS_LESS
+#define PRIORITY_IS_LESS(a, b) ((a) < (b))
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#define FIPQUEUE_TYPE         struct FIPQUEUE_NAME
+#define FIPQUEUE_ELEMENT_TYPE struct JOIN(FIPQUEUE_NAME, element)
+#define FIPQUEUE_INIT         JOIN(FIPQUEUE_NAME, init)
+#define FIPQUEUE_IS_EMPTY     JOIN(FIPQUEUE_NAME, is_empty)
+#define FIPQUEUE_IS_FULL      JOIN(FIPQUEUE_NAME, is_full)
+#define FIPQUEUE_CONTAINS     JOIN(FIPQUEUE_NAME, contains)
+#define FIPQUEUE_REMOVE       JOIN(FIPQUEUE_NAME, remove)
+#define FIPQUEUE_UPHEAP       JOIN(internal, JOIN(FIPQUEUE_NAME, upheap))
+#define FIPQUEUE_DOWNHEAP     JOIN(internal, JOIN(FIPQUEUE_NAME, downheap))
+#define FIPQUEUE_PLACE        JOIN(internal, JOIN(FIPQUEUE_NAME, place))
+
+#define FIPQUEUE_FIRST_CHILD(index) (2 * (index) + 1)
+#define FIPQUEUE_PARENT(index)      (((index) - 1) / 2)
+/// @endcond
+
+// }}}
+
+// type definitions: {{{
+
+/**
+ * @brief Generated priority queue element struct type for a given `VALUE_TYPE`.
+ */
+struct JOIN(FIPQUEUE_NAME, element) {
+    PRIORITY_TYPE priority; ///< Element priority (highest is next to-be-popped).
+    uint32_t handle;        ///< Element handle.
+    VALUE_TYPE value;       ///< Element value member.
+};
+
+/**
+ * @brief Generated priority queue struct type for a given `VALUE_TYPE`.
+ */
+struct FIPQUEUE_NAME {
+    uint32_t count;                   ///< Number of non-empty elements.
+    uint32_t capacity;                ///< Number of elements (and handles) allocated for.
+    uint32_t *positions;              ///< Heap index of each handle, or `FIPQUEUE_NOT_QUEUED`.
+    FIPQUEUE_ELEMENT_TYPE elements[]; ///< Array of elements. Followed by the position map.
+};
+
+// }}}
+
+// function definitions: {{{
+
+/// @cond DO_NOT_DOCUMENT
+
+/* move a hole at index down the heap, and place the element where it stops */
+static inline void JOIN(internal, JOIN(FIPQUEUE_NAME, downheap))(FIPQUEUE_TYPE *self, uint32_t index,
+                                                                 const FIPQUEUE_ELEMENT_TYPE element);
+
+/* move a hole at index up the heap, and place the element where it stops */
+static inline void JOIN(internal, JOIN(FIPQUEUE_NAME, upheap))(FIPQUEUE_TYPE *self, uint32_t index,
+                                                               const FIPQUEUE_ELEMENT_TYPE element);
+
+/* write an element at index, and record the index in the position map */
+static inline void JOIN(internal, JOIN(FIPQUEUE_NAME, place))(FIPQUEUE_TYPE *self, const uint32_t index,
+                                                              const FIPQUEUE_ELEMENT_TYPE element);
+
+/// @endcond
+
+/**
+ * @brief Initialize a priority queue struct, given a capacity and a position
+ *        map of the same length.
+ *
+ * @param[in] self              Priority queue pointer
+ * @param[in] capacity          Capacity
+ * @param[in] positions         Position map with `capacity` entries.
+ */
+static inline FIPQUEUE_TYPE *JOIN(FIPQUEUE_NAME, init)(FIPQUEUE_TYPE *self, const uint32_t capacity,
+                                                       uint32_t *positions)
+{
+    assert(self);
+    assert(positions);
+
+    self->count = 0;
+    self->capacity = capacity;
+    self->positions = positions;
+
+    for (uint32_t handle = 0; handle < capacity; handle++) {
+        self->positions[handle] = FIPQUEUE_NOT_QUEUED;
+    }
+
+    return self;
+}
+
+/**
+ * @brief Create an priority queue struct with a given capacity with malloc().
+ *
+ * @param[in] capacity          Maximum number of elements expected to be stored. Handles are in `[0, capacity)`.
+ *
+ * @return                      A pointer to the priority queue.
+ * @retval NULL
+ *   @li                        If capacity is 0 or the equivalent size overflows.
+ *   @li                        If malloc fails.
+ */
+static inline FIPQUEUE_TYPE *JOIN(FIPQUEUE_NAME, create)(const uint32_t capacity)
+{
+    if (capacity == 0 || fipqueue_calc_sizeof_overflows(FIPQUEUE_NAME, capacity)) {
+        return NULL;
+    }
+
+    const uint32_t size = fipqueue_calc_sizeof(FIPQUEUE_NAME, capacity);
+
+    FIPQUEUE_TYPE *self = (FIPQUEUE_TYPE *)calloc(1, size);
+
+    if (!self) {
+        return NULL;
+    }
+
+    FIPQUEUE_INIT(self, capacity, (uint32_t *)&self->elements[capacity]);
+
+    return self;
+}
+
+/**
+ * @brief Destroy an priority queue struct and free the underlying memory with free().
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The priority queue pointer.
+ */
+static inline void JOIN(FIPQUEUE_NAME, destroy)(FIPQUEUE_TYPE *self)
+{
+    assert(self != NULL);
+
+    free(self);
+}
+
+/**
+ * @brief Return whether the priority queue is empty.
+ *
+ * @param[in] self              The priority queue pointer.
+ *
+ * @return                      Whether the priority queue is empty.
+ */
+static inline bool JOIN(FIPQUEUE_NAME, is_empty)(const FIPQUEUE_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == 0;
+}
+
+/**
+ * @brief Return whether the priority queue is full.
+ *
+ * @param[in] self              The priority queue pointer.
+ *
+ * @return                      Whether the priority queue is full.
+ */
+static inline bool JOIN(FIPQUEUE_NAME, is_full)(const FIPQUEUE_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == self->capacity;
+}
+
+/**
+ * @brief Return whether a handle is in the priority queue.
+ *
+ * @param[in] self              The priority queue pointer.
+ * @param[in] handle            The handle. Must be less than the capacity.
+ *
+ * @return                      Whether the handle is in the priority queue.
+ */
+static inline bool JOIN(FIPQUEUE_NAME, contains)(const FIPQUEUE_TYPE *self, const uint32_t handle)
+{
+    assert(self != NULL);
+    assert(handle < self->capacity);
+
+    return self->positions[handle] != FIPQUEUE_NOT_QUEUED;
+}
+
+/**
+ * @brief Get the max priority value in a non-empty priority queue.
+ *
+ * @param[in] self              The priority queue pointer.
+ *
+ * @return                      The max priority value.
+ */
+static inline VALUE_TYPE JOIN(FIPQUEUE_NAME, get_max)(const FIPQUEUE_TYPE *self)
+{
+    assert(self != NULL);
+    assert(FIPQUEUE_IS_EMPTY(self) == false);
+
+    return self->elements[0].value;
+}
+
+/**
+ * @brief Get the handle of the max priority value in a non-empty priority
+ *        queue.
+ *
+ * @param[in] self              The priority queue pointer.
+ *
+ * @return                      The handle of the max priority value.
+ */
+static inline uint32_t JOIN(FIPQUEUE_NAME, get_max_handle)(const FIPQUEUE_TYPE *self)
+{
+    assert(self != NULL);
+    assert(FIPQUEUE_IS_EMPTY(self) == false);
+
+    return self->elements[0].handle;
+}
+
+/**
+ * @brief Peek a non-empty priority queue and get it's next to-be-popped (max priority)
+ *        value.
+ *
+ * @param[in] self              The priority queue pointer.
+ *
+ * @return                      The next to-be-popped (max priority) value.
+ */
+static inline VALUE_TYPE JOIN(FIPQUEUE_NAME, peek)(const FIPQUEUE_TYPE *self)
+{
+    return JOIN(FIPQUEUE_NAME, get_max)(self);
+}
+
+/**
+ * @brief Get the value of a handle in the priority queue.
+ *
+ * @param[in] self              The priority queue pointer.
+ * @param[in] handle            The handle. Must be in the priority queue.
+ *
+ * @return                      The value.
+ */
+static inline VALUE_TYPE JOIN(FIPQUEUE_NAME, get_value)(const FIPQUEUE_TYPE *self, const uint32_t handle)
+{
+    assert(FIPQUEUE_CONTAINS(self, handle));
+
+    return self->elements[self->positions[handle]].value;
+}
+
+/**
+ * @brief Get the priority of a handle in the priority queue.
+ *
+ * @param[in] self              The priority queue pointer.
+ * @param[in] handle            The handle. Must be in the priority queue.
+ *
+ * @return                      The priority.
+ */
+static inline PRIORITY_TYPE JOIN(FIPQUEUE_NAME, get_priority)(const FIPQUEUE_TYPE *self, const uint32_t handle)
+{
+    assert(FIPQUEUE_CONTAINS(self, handle));
+
+    return self->elements[self->positions[handle]].priority;
+}
+
+/**
+ * @brief Push a value with a given handle and priority into a non-full priority
+ *        queue.
+ *
+ * @param[in] self              The priority queue pointer.
+ * @param[in] handle            The handle. Must not already be in the priority queue.
+ * @param[in] value             The value.
+ * @param[in] priority          The priority (with large number meaning high
+ *                              priority and vice versa, unless `PRIORITY_IS_LESS`
+ *                              is defined otherwise).
+ */
+static inline void JOIN(FIPQUEUE_NAME, push)(FIPQUEUE_TYPE *self, const uint32_t handle, VALUE_TYPE value,
+                                             PRIORITY_TYPE priority)
+{
+    assert(self != NULL);
+    assert(FIPQUEUE_IS_FULL(self) == false);
+    assert(FIPQUEUE_CONTAINS(self, handle) == false);
+
+    const uint32_t index = self->count;
+
+    self->count++;
+
+    FIPQUEUE_UPHEAP(self, index, (FIPQUEUE_ELEMENT_TYPE){.priority = priority, .handle = handle, .value = value});
+}
+
+/**
+ * @brief Remove the value with a given handle from the priority queue.
+ *
+ * @param[in] self              The priority queue pointer.
+ * @param[in] handle            The handle. Must be in the priority queue.
+ *
+ * @return                      The removed value.
+ */
+static inline VALUE_TYPE JOIN(FIPQUEUE_NAME, remove)(FIPQUEUE_TYPE *self, const uint32_t handle)
+{
+    assert(self != NULL);
+    assert(FIPQUEUE_CONTAINS(self, handle));
+
+    const uint32_t index = self->positions[handle];
+    const FIPQUEUE_ELEMENT_TYPE removed = self->elements[index];
+
+    self->positions[handle] = FIPQUEUE_NOT_QUEUED;
+    self->count--;
+
+    if (index != self->count) {
+        const FIPQUEUE_ELEMENT_TYPE last = self->elements[self->count];
+
+        if (PRIORITY_IS_LESS(removed.priority, last.priority)) {
+            FIPQUEUE_UPHEAP(self, index, last);
+        }
+        else {
+            FIPQUEUE_DOWNHEAP(self, index, last);
+        }
+    }
+
+    return removed.value;
+}
+
+/**
+ * @brief Pop the max priority value away from a non-empty priority queue.
+ *
+ * @param[in] self              The priority queue pointer.
+ *
+ * @return                      The max value.
+ */
+static inline VALUE_TYPE JOIN(FIPQUEUE_NAME, pop_max)(FIPQUEUE_TYPE *self)
+{
+    assert(self != NULL);
+    assert(FIPQUEUE_IS_EMPTY(self) == false);
+
+    return FIPQUEUE_REMOVE(self, self->elements[0].handle);
+}
+
+/**
+ * @brief Change the priority of a handle in the priority queue, and move it
+ *        up or down the heap accordingly.
+ *
+ * @param[in] self              The priority queue pointer.
+ * @param[in] handle            The handle. Must be in the priority queue.
+ * @param[in] priority          The new priority.
+ */
+static inline void JOIN(FIPQUEUE_NAME, update_priority)(FIPQUEUE_TYPE *self, const uint32_t handle,
+                                                        PRIORITY_TYPE priority)
+{
+    assert(self != NULL);
+    assert(FIPQUEUE_CONTAINS(self, handle));
+
+    const uint32_t index = self->positions[handle];
+    FIPQUEUE_ELEMENT_TYPE element = self->elements[index];
+
+    const bool increased = PRIORITY_IS_LESS(element.priority, priority);
+
+    element.priority = priority;
+
+    if (increased) {
+        FIPQUEUE_UPHEAP(self, index, element);
+    }
+    else {
+        FIPQUEUE_DOWNHEAP(self, index, element);
+    }
+}
+
+/**
+ * @brief Clear the elements in the priority queue.
+ *
+ * @param[in] self              The priority queue pointer.
+ */
+static inline void JOIN(FIPQUEUE_NAME, clear)(FIPQUEUE_TYPE *self)
+{
+    assert(self != NULL);
+
+    for (uint32_t i = 0; i < self->count; i++) {
+        self->positions[self->elements[i].handle] = FIPQUEUE_NOT_QUEUED;
+    }
+    self->count = 0;
+}
+
+/**
+ * @brief Copy the values from a source priority queue to a destination priority
+ *        queue.
+ *
+ * @param[in,out] dest_ptr      The destination priority queue. Must have the same capacity as the source.
+ * @param[in] src_ptr           The source priority queue.
+ */
+static inline void JOIN(FIPQUEUE_NAME, copy)(FIPQUEUE_TYPE *restrict dest_ptr, const FIPQUEUE_TYPE *restrict src_ptr)
+{
+    assert(src_ptr != NULL);
+    assert(dest_ptr != NULL);
+    assert(src_ptr->capacity == dest_ptr->capacity);
+    assert(FIPQUEUE_IS_EMPTY(dest_ptr));
+
+    for (uint32_t i = 0; i < src_ptr->count; i++) {
+        FIPQUEUE_PLACE(dest_ptr, i, src_ptr->elements[i]);
+    }
+    dest_ptr->count = src_ptr->count;
+}
+
+/// @cond DO_NOT_DOCUMENT
+
+static inline void JOIN(internal, JOIN(FIPQUEUE_NAME, place))(FIPQUEUE_TYPE *self, const uint32_t index,
+                                                              const FIPQUEUE_ELEMENT_TYPE element)
+{
+    self->elements[index] = element;
+    self->positions[element.handle] = index;
+}
+
+static inline void JOIN(internal, JOIN(FIPQUEUE_NAME, upheap))(FIPQUEUE_TYPE *self, uint32_t index,
+                                                               const FIPQUEUE_ELEMENT_TYPE element)
+{
+    assert(self != NULL);
+    assert(index < self->count);
+
+    while (index > 0) {
+        const uint32_t parent = FIPQUEUE_PARENT(index);
+
+        const bool sorted = !PRIORITY_IS_LESS(self->elements[parent].priority, element.priority);
+
+        if (sorted) {
+            break;
+        }
+
+        FIPQUEUE_PLACE(self, index, self->elements[parent]);
+        index = parent;
+    }
+
+    FIPQUEUE_PLACE(self, index, element);
+}
+
+static inline void JOIN(internal, JOIN(FIPQUEUE_NAME, downheap))(FIPQUEUE_TYPE *self, uint32_t index,
+                                                                 const FIPQUEUE_ELEMENT_TYPE element)
+{
+    assert(self != NULL);
+    assert(index < self->count);
+
+    while (FIPQUEUE_FIRST_CHILD(index) < self->count) {
+        uint32_t largest = FIPQUEUE_FIRST_CHILD(index);
+
+        if (largest + 1 < self->count
+            && PRIORITY_IS_LESS(self->elements[largest].priority, self->elements[largest + 1].priority)) {
+            largest++;
+        }
+
+        const bool sorted = !PRIORITY_IS_LESS(element.priority, self->elements[largest].priority);
+
+        if (sorted) {
+            break;
+        }
+
+        FIPQUEUE_PLACE(self, index, self->elements[largest]);
+        index = largest;
+    }
+
+    FIPQUEUE_PLACE(self, index, element);
+}
+
+/// @endcond
+
+// }}}
+
+// macro undefs: {{{
+
+#undef NAME
+#undef VALUE_TYPE
+#undef PRIORITY_TYPE
+#undef PRIORITY_IS_LESS
+
+#undef FIPQUEUE_NAME
+#undef FIPQUEUE_TYPE
+#undef FIPQUEUE_ELEMENT_TYPE
+#undef FIPQUEUE_INIT
+#undef FIPQUEUE_IS_EMPTY
+#undef FIPQUEUE_IS_FULL
+#undef FIPQUEUE_CONTAINS
+#undef FIPQUEUE_REMOVE
+#undef FIPQUEUE_UPHEAP
+#undef FIPQUEUE_DOWNHEAP
+#undef FIPQUEUE_PLACE
+#undef FIPQUEUE_FIRST_CHILD
+#undef FIPQUEUE_PARENT
+
+// }}}
+
+// vim: ft=c fdm=marker
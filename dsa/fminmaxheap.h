@@ -0,0 +1,559 @@
+/*  fminmaxheap.h
+ *
+ *  Copyright (C) 2023 abxh
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *  See the file LICENSE included with this distribution for more
+ *  information. */
+
+/**
+ * @file fminmaxheap.h
+ * @brief Fixed-size double-ended priority queue based on min-max heap.
+ *
+ * A binary heap in a single array, where the levels alternate between min
+ * levels and max levels, starting with a min level at the root. An element on
+ * a min level is not greater than any of its descendants, and an element on a
+ * max level is not less than any of its descendants. The min element is thus
+ * the root, and the max element is one of its children, such that `get_min`
+ * and `get_max` are O(1), and `push`, `pop_min` and `pop_max` are O(log n).
+ *
+ * The following macros must be defined:
+ *  @li `NAME`
+ *  @li `VALUE_TYPE`
+ *
+ * The following macros can be defined:
+ *  @li `PRIORITY_TYPE`
+ *  @li `PRIORITY_IS_LESS`
+ *
+ * Sources used:
+ * @li https://en.wikipedia.org/wiki/Min-max_heap
+ * @li https://cglab.ca/~morin/teaching/5408/refs/minmax.pdf
+ */
+
+// macro definitions: {{{
+
+#ifndef FMINMAXHEAP_H
+#define FMINMAXHEAP_H
+
+#include "paste.h" // PASTE, XPASTE, JOIN
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * @def fminmaxheap_for_each(self, index, value_)
+ * @brief Iterate over the values in the heap in breadth-first order.
+ *
+ * @warning Modifying the heap under the iteration may result in errors.
+ *
+ * @param[in] self              Heap pointer.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t`.
+ * @param[out] value_           Current value. Should be `VALUE_TYPE`.
+ */
+#define fminmaxheap_for_each(self, index, value_) \
+    for ((index) = 0; (index) < (self)->count && ((value_) = (self)->elements[(index)].value, true); (index)++)
+
+/**
+ * @def fminmaxheap_calc_sizeof(fminmaxheap_name, capacity)
+ *
+ * @brief Calculate the size of the heap struct. No overflow checks.
+ *
+ * @param[in] fminmaxheap_name  Defined heap NAME.
+ * @param[in] capacity          Capacity input.
+ *
+ * @return                      The equivalent size.
+ */
+#define fminmaxheap_calc_sizeof(fminmaxheap_name, capacity) \
+    (uint32_t)(offsetof(struct fminmaxheap_name, elements)   \
+               + capacity * sizeof(((struct fminmaxheap_name *)0)->elements[0]))
+
+/**
+ * @def fminmaxheap_calc_sizeof_overflows(fminmaxheap_name, capacity)
+ *
+ * @brief Check for a given capacity, if the equivalent size of the heap struct overflows.
+ *
+ * @param[in] fminmaxheap_name  Defined heap NAME.
+ * @param[in] capacity          Capacity input.
+ *
+ * @return                      Whether the equivalent size overflows.
+ */
+#define fminmaxheap_calc_sizeof_overflows(fminmaxheap_name, capacity)         \
+    (capacity > (UINT32_MAX - offsetof(struct fminmaxheap_name, elements)) \
+                    / sizeof(((struct fminmaxheap_name *)0)->elements[0]))
+
+/// @cond DO_NOT_DOCUMENT
+/* whether the element at index is on a min level, i.e. at an even depth */
+static inline bool internal_fminmaxheap_is_min_level(const uint32_t index)
+{
+// Test for GCC >= 3.4.0
+#if defined(__GNUC__) && (__GNUC__ > 3 || (__GNUC__ == 3 && (__GNUC_MINOR__ > 4 || __GNUC_MINOR__ == 4)))
+
+    const uint32_t depth = 31U - (uint32_t)__builtin_clz(index + 1U);
+
+#else
+    uint32_t depth = 0;
+    for (uint32_t n = index + 1U; n > 1; n >>= 1) {
+        depth++;
+    }
+#endif
+    return depth % 2 == 0;
+}
+/// @endcond
+
+#endif // FMINMAXHEAP_H
+
+/**
+ * @def NAME
+ * @brief Prefix to heap types and operations. This must be manually defined
+ *        before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef NAME
+#define NAME fminmaxheap
+#error "Must define NAME."
+#else
+#define FMINMAXHEAP_NAME NAME
+#endif
+
+/**
+ * @def VALUE_TYPE
+ * @brief Heap value type. This must be manually defined before including this
+ *        header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef VALUE_TYPE
+#error "Must declare VALUE_TYPE."
+#define VALUE_TYPE int
+#endif
+
+/**
+ * @def PRIORITY_TYPE
+ * @brief Priority type. Defaults to `uint32_t`.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef PRIORITY_TYPE
+#define PRIORITY_TYPE uint32_t
+#endif
+
+/**
+ * @def PRIORITY_IS_LESS(a, b)
+ * @brief Used to compare two priorities. Defaults to `(a) < (b)`.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef PRIORITY_IS_LESS
+#define PRIORITY_IS_LESS(a, b) ((a) < (b))
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#define FMINMAXHEAP_TYPE         struct FMINMAXHEAP_NAME
+#define FMINMAXHEAP_ELEMENT_TYPE struct JOIN(FMINMAXHEAP_NAME, element)
+#define FMINMAXHEAP_INIT         JOIN(FMINMAXHEAP_NAME, init)
+#define FMINMAXHEAP_IS_EMPTY     JOIN(FMINMAXHEAP_NAME, is_empty)
+#define FMINMAXHEAP_IS_FULL      JOIN(FMINMAXHEAP_NAME, is_full)
+#define FMINMAXHEAP_MAX_INDEX    JOIN(internal, JOIN(FMINMAXHEAP_NAME, max_index))
+#define FMINMAXHEAP_BUBBLE_UP    JOIN(internal, JOIN(FMINMAXHEAP_NAME, bubble_up))
+#define FMINMAXHEAP_TRICKLE_DOWN JOIN(internal, JOIN(FMINMAXHEAP_NAME, trickle_down))
+#define FMINMAXHEAP_REMOVE_AT    JOIN(internal, JOIN(FMINMAXHEAP_NAME, remove_at))
+
+#define FMINMAXHEAP_PARENT(index) (((index) - 1) / 2)
+
+/* whether priority a must be placed above priority b on a min level (or a max level if not min_level) */
+#define FMINMAXHEAP_IS_BEFORE(min_level, a, b) ((min_level) ? PRIORITY_IS_LESS(a, b) : PRIORITY_IS_LESS(b, a))
+/// @endcond
+
+// }}}
+
+// type definitions: {{{
+
+/**
+ * @brief Generated heap element struct type for a given `VALUE_TYPE`.
+ */
+struct JOIN(FMINMAXHEAP_NAME, element) {
+    PRIORITY_TYPE priority; ///< Element priority.
+    VALUE_TYPE value;       ///< Element value member.
+};
+
+/**
+ * @brief Generated heap struct type for a given `VALUE_TYPE`.
+ */
+struct FMINMAXHEAP_NAME {
+    uint32_t count;                      ///< Number of non-empty elements.
+    uint32_t capacity;                   ///< Number of elements allocated for.
+    FMINMAXHEAP_ELEMENT_TYPE elements[]; ///< Array of elements.
+};
+
+// }}}
+
+// function definitions: {{{
+
+/// @cond DO_NOT_DOCUMENT
+
+/* get the index of the max element in a non-empty heap */
+static inline uint32_t JOIN(internal, JOIN(FMINMAXHEAP_NAME, max_index))(const FMINMAXHEAP_TYPE *self);
+
+/* move a hole at index up the heap, and place the element where it stops. for restoring the heap property after
+ * insertion */
+static inline void JOIN(internal, JOIN(FMINMAXHEAP_NAME, bubble_up))(FMINMAXHEAP_TYPE *self, uint32_t index,
+                                                                     FMINMAXHEAP_ELEMENT_TYPE element);
+
+/* move a hole at index down the heap along its min levels or max levels, and place the element where it stops. for
+ * restoring the heap property after deletion */
+static inline void JOIN(internal, JOIN(FMINMAXHEAP_NAME, trickle_down))(FMINMAXHEAP_TYPE *self, uint32_t index,
+                                                                        FMINMAXHEAP_ELEMENT_TYPE element);
+
+/* remove the element at index, and return its value */
+static inline VALUE_TYPE JOIN(internal, JOIN(FMINMAXHEAP_NAME, remove_at))(FMINMAXHEAP_TYPE *self,
+                                                                           const uint32_t index);
+
+/// @endcond
+
+/**
+ * @brief Initialize a heap struct, given a capacity.
+ *
+ * @param[in] self              Heap pointer
+ * @param[in] capacity          Capacity
+ */
+static inline FMINMAXHEAP_TYPE *JOIN(FMINMAXHEAP_NAME, init)(FMINMAXHEAP_TYPE *self, const uint32_t capacity)
+{
+    assert(self);
+
+    self->count = 0;
+    self->capacity = capacity;
+
+    return self;
+}
+
+/**
+ * @brief Create a heap struct with a given capacity with malloc().
+ *
+ * @param[in] capacity          Maximum number of elements expected to be stored.
+ *
+ * @return                      A pointer to the heap.
+ * @retval NULL
+ *   @li                        If capacity is 0 or the equivalent size overflows.
+ *   @li                        If malloc fails.
+ */
+static inline FMINMAXHEAP_TYPE *JOIN(FMINMAXHEAP_NAME, create)(const uint32_t capacity)
+{
+    if (capacity == 0 || fminmaxheap_calc_sizeof_overflows(FMINMAXHEAP_NAME, capacity)) {
+        return NULL;
+    }
+
+    const uint32_t size = fminmaxheap_calc_sizeof(FMINMAXHEAP_NAME, capacity);
+
+    FMINMAXHEAP_TYPE *self = (FMINMAXHEAP_TYPE *)calloc(1, size);
+
+    if (!self) {
+        return NULL;
+    }
+
+    FMINMAXHEAP_INIT(self, capacity);
+
+    return self;
+}
+
+/**
+ * @brief Destroy a heap struct and free the underlying memory with free().
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The heap pointer.
+ */
+static inline void JOIN(FMINMAXHEAP_NAME, destroy)(FMINMAXHEAP_TYPE *self)
+{
+    assert(self != NULL);
+
+    free(self);
+}
+
+/**
+ * @brief Return whether the heap is empty.
+ *
+ * @param[in] self              The heap pointer.
+ *
+ * @return                      Whether the heap is empty.
+ */
+static inline bool JOIN(FMINMAXHEAP_NAME, is_empty)(const FMINMAXHEAP_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == 0;
+}
+
+/**
+ * @brief Return whether the heap is full.
+ *
+ * @param[in] self              The heap pointer.
+ *
+ * @return                      Whether the heap is full.
+ */
+static inline bool JOIN(FMINMAXHEAP_NAME, is_full)(const FMINMAXHEAP_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == self->capacity;
+}
+
+/**
+ * @brief Get the min priority value in a non-empty heap.
+ *
+ * @param[in] self              The heap pointer.
+ *
+ * @return                      The min priority value.
+ */
+static inline VALUE_TYPE JOIN(FMINMAXHEAP_NAME, get_min)(const FMINMAXHEAP_TYPE *self)
+{
+    assert(self != NULL);
+    assert(FMINMAXHEAP_IS_EMPTY(self) == false);
+
+    return self->elements[0].value;
+}
+
+/**
+ * @brief Get the max priority value in a non-empty heap.
+ *
+ * @param[in] self              The heap pointer.
+ *
+ * @return                      The max priority value.
+ */
+static inline VALUE_TYPE JOIN(FMINMAXHEAP_NAME, get_max)(const FMINMAXHEAP_TYPE *self)
+{
+    assert(self != NULL);
+    assert(FMINMAXHEAP_IS_EMPTY(self) == false);
+
+    return self->elements[FMINMAXHEAP_MAX_INDEX(self)].value;
+}
+
+/**
+ * @brief Pop the min priority value away from a non-empty heap.
+ *
+ * @param[in] self              The heap pointer.
+ *
+ * @return                      The min priority value.
+ */
+static inline VALUE_TYPE JOIN(FMINMAXHEAP_NAME, pop_min)(FMINMAXHEAP_TYPE *self)
+{
+    assert(self != NULL);
+    assert(FMINMAXHEAP_IS_EMPTY(self) == false);
+
+    return FMINMAXHEAP_REMOVE_AT(self, 0);
+}
+
+/**
+ * @brief Pop the max priority value away from a non-empty heap.
+ *
+ * @param[in] self              The heap pointer.
+ *
+ * @return                      The max priority value.
+ */
+static inline VALUE_TYPE JOIN(FMINMAXHEAP_NAME, pop_max)(FMINMAXHEAP_TYPE *self)
+{
+    assert(self != NULL);
+    assert(FMINMAXHEAP_IS_EMPTY(self) == false);
+
+    return FMINMAXHEAP_REMOVE_AT(self, FMINMAXHEAP_MAX_INDEX(self));
+}
+
+/**
+ * @brief Push a value with given priority onto a non-full heap.
+ *
+ * @param[in] self              The heap pointer.
+ * @param[in] value             The value.
+ * @param[in] priority          The priority.
+ */
+static inline void JOIN(FMINMAXHEAP_NAME, push)(FMINMAXHEAP_TYPE *self, VALUE_TYPE value, PRIORITY_TYPE priority)
+{
+    assert(self != NULL);
+    assert(FMINMAXHEAP_IS_FULL(self) == false);
+
+    const uint32_t index = self->count;
+
+    self->count++;
+
+    FMINMAXHEAP_BUBBLE_UP(self, index, (FMINMAXHEAP_ELEMENT_TYPE){.priority = priority, .value = value});
+}
+
+/**
+ * @brief Clear the elements in the heap.
+ *
+ * @param[in] self              The heap pointer.
+ */
+static inline void JOIN(FMINMAXHEAP_NAME, clear)(FMINMAXHEAP_TYPE *self)
+{
+    assert(self != NULL);
+
+    self->count = 0;
+}
+
+/**
+ * @brief Copy the values from a source heap to a destination heap.
+ *
+ * @param[in,out] dest_ptr      The destination heap.
+ * @param[in] src_ptr           The source heap.
+ */
+static inline void JOIN(FMINMAXHEAP_NAME, copy)(FMINMAXHEAP_TYPE *restrict dest_ptr,
+                                                const FMINMAXHEAP_TYPE *restrict src_ptr)
+{
+    assert(src_ptr != NULL);
+    assert(dest_ptr != NULL);
+    assert(src_ptr->count <= dest_ptr->capacity);
+    assert(FMINMAXHEAP_IS_EMPTY(dest_ptr));
+
+    for (uint32_t i = 0; i < src_ptr->count; i++) {
+        dest_ptr->elements[i] = src_ptr->elements[i];
+    }
+    dest_ptr->count = src_ptr->count;
+}
+
+/// @cond DO_NOT_DOCUMENT
+
+static inline uint32_t JOIN(internal, JOIN(FMINMAXHEAP_NAME, max_index))(const FMINMAXHEAP_TYPE *self)
+{
+    if (self->count <= 2) {
+        return self->count - 1;
+    }
+    return PRIORITY_IS_LESS(self->elements[1].priority, self->elements[2].priority) ? 2 : 1;
+}
+
+static inline void JOIN(internal, JOIN(FMINMAXHEAP_NAME, bubble_up))(FMINMAXHEAP_TYPE *self, uint32_t index,
+                                                                     FMINMAXHEAP_ELEMENT_TYPE element)
+{
+    assert(self != NULL);
+    assert(index < self->count);
+
+    if (index == 0) {
+        self->elements[index] = element;
+        return;
+    }
+
+    bool min_level = internal_fminmaxheap_is_min_level(index);
+
+    const uint32_t parent = FMINMAXHEAP_PARENT(index);
+
+    /* an element that belongs above its parent goes up along the levels of the parent instead */
+    if (FMINMAXHEAP_IS_BEFORE(!min_level, element.priority, self->elements[parent].priority)) {
+        self->elements[index] = self->elements[parent];
+        index = parent;
+        min_level = !min_level;
+    }
+
+    while (index > 2) {
+        const uint32_t grandparent = FMINMAXHEAP_PARENT(FMINMAXHEAP_PARENT(index));
+
+        if (!FMINMAXHEAP_IS_BEFORE(min_level, element.priority, self->elements[grandparent].priority)) {
+            break;
+        }
+
+        self->elements[index] = self->elements[grandparent];
+        index = grandparent;
+    }
+
+    self->elements[index] = element;
+}
+
+static inline void JOIN(internal, JOIN(FMINMAXHEAP_NAME, trickle_down))(FMINMAXHEAP_TYPE *self, uint32_t index,
+                                                                        FMINMAXHEAP_ELEMENT_TYPE element)
+{
+    assert(self != NULL);
+    assert(index < self->count);
+
+    const bool min_level = internal_fminmaxheap_is_min_level(index);
+
+    while (2 * index + 1 < self->count) {
+        /* find the first among the children and grandchildren */
+        const uint32_t first_child = 2 * index + 1;
+        const uint32_t first_grandchild = 4 * index + 3;
+        const uint32_t end_child = first_child + 2 < self->count ? first_child + 2 : self->count;
+        const uint32_t end_grandchild = first_grandchild + 4 < self->count ? first_grandchild + 4 : self->count;
+
+        uint32_t first = first_child;
+        for (uint32_t i = first_child + 1; i < end_child; i++) {
+            if (FMINMAXHEAP_IS_BEFORE(min_level, self->elements[i].priority, self->elements[first].priority)) {
+                first = i;
+            }
+        }
+        for (uint32_t i = first_grandchild; i < end_grandchild; i++) {
+            if (FMINMAXHEAP_IS_BEFORE(min_level, self->elements[i].priority, self->elements[first].priority)) {
+                first = i;
+            }
+        }
+
+        if (!FMINMAXHEAP_IS_BEFORE(min_level, self->elements[first].priority, element.priority)) {
+            break;
+        }
+
+        self->elements[index] = self->elements[first];
+        index = first;
+
+        if (first < first_grandchild) {
+            /* a child has no descendants on the same kind of level */
+            break;
+        }
+
+        /* the element may belong above the parent of the grandchild, which is on the other kind of level */
+        const uint32_t parent = FMINMAXHEAP_PARENT(first);
+
+        if (FMINMAXHEAP_IS_BEFORE(!min_level, element.priority, self->elements[parent].priority)) {
+            const FMINMAXHEAP_ELEMENT_TYPE parent_element = self->elements[parent];
+            self->elements[parent] = element;
+            element = parent_element;
+        }
+    }
+
+    self->elements[index] = element;
+}
+
+static inline VALUE_TYPE JOIN(internal, JOIN(FMINMAXHEAP_NAME, remove_at))(FMINMAXHEAP_TYPE *self,
+                                                                           const uint32_t index)
+{
+    assert(self != NULL);
+    assert(index < self->count);
+
+    VALUE_TYPE const value = self->elements[index].value;
+
+    self->count--;
+
+    if (index < self->count) {
+        FMINMAXHEAP_TRICKLE_DOWN(self, index, self->elements[self->count]);
+    }
+
+    return value;
+}
+
+/// @endcond
+
+// }}}
+
+// macro undefs: {{{
+
+#undef NAME
+#undef VALUE_TYPE
+#undef PRIORITY_TYPE
+#undef PRIORITY_IS_LESS
+
+#undef FMINMAXHEAP_NAME
+#undef FMINMAXHEAP_TYPE
+#undef FMINMAXHEAP_ELEMENT_TYPE
+#undef FMINMAXHEAP_INIT
+#undef FMINMAXHEAP_IS_EMPTY
+#undef FMINMAXHEAP_IS_FULL
+#undef FMINMAXHEAP_MAX_INDEX
+#undef FMINMAXHEAP_BUBBLE_UP
+#undef FMINMAXHEAP_TRICKLE_DOWN
+#undef FMINMAXHEAP_REMOVE_AT
+#undef FMINMAXHEAP_PARENT
+#undef FMINMAXHEAP_IS_BEFORE
+
+// }}}
+
+// vim: ft=c fdm=marker
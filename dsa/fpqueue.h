@@ -11,14 +11,35 @@
 
 /**
  * @file fpqueue.h
- * @brief Fixed-size priority queue based on binary (max-)heap.
+ * @brief Fixed-size priority queue based on d-ary heap.
+ *
+ * An implicit heap in a single array, where every node has `ARITY` children
+ * (2 by default) stored next to each other. The element with a priority that
+ * is not less than any other by `PRIORITY_IS_LESS` is at the root, such that
+ * `get_max` is O(1), and `push` and `pop_max` are O(log n). It is a max-heap
+ * by default, and a min-heap with `PRIORITY_IS_LESS` defined as `(a) > (b)`.
+ * Elements with equal priorities are popped in no particular order, unless
+ * `STABLE` is defined, in which case they are popped in the order they were
+ * pushed.
+ *
+ * The heap can also be built from an array in O(n) (`create_from_array`,
+ * and `push_n` for large batches), keep the K elements with the lowest
+ * priorities (`push_bounded`), and be drained in sorted order
+ * (`drain_sorted`).
  *
  * The following macros must be defined:
  *  @li `NAME`
  *  @li `VALUE_TYPE`
  *
- * Source used:
+ * The following macros can be defined:
+ *  @li `ARITY`
+ *  @li `PRIORITY_TYPE`
+ *  @li `PRIORITY_IS_LESS`
+ *  @li `STABLE`
+ *
+ * Sources used:
  * @li CLRS
+ * @li https://en.wikipedia.org/wiki/D-ary_heap
  */
 
 // macro definitions: {{{
@@ -36,7 +57,8 @@
 
 /**
  * @def fpqueue_left_child(index)
- * @brief Given an element index, get the index of the left child.
+ * @brief Given an element index, get the index of the left child. For the
+ *        default `ARITY` of 2.
  *
  * @param[in] index The element index.
  */
@@ -44,7 +66,8 @@
 
 /**
  * @def fpqueue_right_child(index)
- * @brief Given an element index, get the index of the right child.
+ * @brief Given an element index, get the index of the right child. For the
+ *        default `ARITY` of 2.
  *
  * @param[in] index The element index.
  */
@@ -52,7 +75,8 @@
 
 /**
  * @def fpqueue_parent(index)
- * @brief Given an element index, get the index of the parent.
+ * @brief Given an element index, get the index of the parent. For the default
+ *        `ARITY` of 2.
  *
  * @param[in] index The element index.
  */
@@ -127,15 +151,89 @@
 #define VALUE_TYPE int
 #endif
 
+/**
+ * @def ARITY
+ * @brief Number of children per node in the heap. Defaults to 2 (binary heap).
+ *
+ * A larger arity makes the heap shallower, such that `pop_max` touches fewer
+ * levels, at the cost of more comparisons per level. The children of a node
+ * are stored contiguously, so choose `ARITY` such that
+ * `ARITY * sizeof(element)` is at most a cache line (e.g. 4 or 8 for small
+ * elements).
+ *
+ * Is undefined after header is included.
+ */
+#ifndef ARITY
+#define ARITY 2
+#endif
+
+static_assert(ARITY >= 2, "ARITY must be at least 2.");
+
+/**
+ * @def PRIORITY_TYPE
+ * @brief Priority type. Defaults to `uint32_t`.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef PRIORITY_TYPE
+#define PRIORITY_TYPE uint32_t
+#endif
+
+/**
+ * @def PRIORITY_IS_LESS(a, b)
+ * @brief Used to compare two priorities. The element with a priority that is
+ *        not less than any other is popped first. Defaults to `(a) < (b)`,
+ *        which makes the heap a max-heap.
+ *
+ * Define it as `(a) > (b)` for a min-heap, or as a function call for
+ * composite priorities.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef PRIORITY_IS_LESS
+#define PRIORITY_IS_LESS(a, b) ((a) < (b))
+#endif
+
+/**
+ * @def STABLE
+ * @brief Define to pop elements with equal priorities in the order they were
+ *        pushed (FIFO). Not defined by default.
+ *
+ * Every element is given a 64-bit insertion sequence number, which is compared
+ * when the priorities are equal. The elements and the priority queue struct
+ * are only widened by it when this is defined.
+ *
+ * Is undefined after header is included.
+ */
+#ifdef STABLE
+#define FPQUEUE_STABLE
+#endif
+
 /// @cond DO_NOT_DOCUMENT
-#define FPQUEUE_TYPE         struct FPQUEUE_NAME
-#define FPQUEUE_ELEMENT_TYPE struct JOIN(FPQUEUE_NAME, element)
-#define FPQUEUE_INIT         JOIN(FPQUEUE_NAME, init)
-#define FPQUEUE_IS_EMPTY     JOIN(FPQUEUE_NAME, is_empty)
-#define FPQUEUE_IS_FULL      JOIN(FPQUEUE_NAME, is_full)
-#define FPQUEUE_CALC_SIZEOF  JOIN(FPQUEUE_NAME, calc_sizeof)
-#define FPQUEUE_UPHEAP       JOIN(internal, JOIN(FPQUEUE_NAME, upheap))
-#define FPQUEUE_DOWNHEAP     JOIN(internal, JOIN(FPQUEUE_NAME, downheap))
+#define FPQUEUE_TYPE          struct FPQUEUE_NAME
+#define FPQUEUE_ELEMENT_TYPE  struct JOIN(FPQUEUE_NAME, element)
+#define FPQUEUE_INIT          JOIN(FPQUEUE_NAME, init)
+#define FPQUEUE_CREATE        JOIN(FPQUEUE_NAME, create)
+#define FPQUEUE_IS_EMPTY      JOIN(FPQUEUE_NAME, is_empty)
+#define FPQUEUE_IS_FULL       JOIN(FPQUEUE_NAME, is_full)
+#define FPQUEUE_CALC_SIZEOF   JOIN(FPQUEUE_NAME, calc_sizeof)
+#define FPQUEUE_UPHEAP        JOIN(internal, JOIN(FPQUEUE_NAME, upheap))
+#define FPQUEUE_DOWNHEAP      JOIN(internal, JOIN(FPQUEUE_NAME, downheap))
+#define FPQUEUE_HEAPIFY       JOIN(internal, JOIN(FPQUEUE_NAME, heapify))
+#define FPQUEUE_LARGEST_CHILD JOIN(internal, JOIN(FPQUEUE_NAME, largest_child))
+
+#define FPQUEUE_FIRST_CHILD(index) ((ARITY) * (index) + 1)
+#define FPQUEUE_PARENT(index)      (((index) - 1) / (ARITY))
+
+#ifdef FPQUEUE_STABLE
+#define FPQUEUE_ELEMENT_IS_LESS(a, b) \
+    (PRIORITY_IS_LESS((a).priority, (b).priority) || (!PRIORITY_IS_LESS((b).priority, (a).priority) && (a).seq > (b).seq))
+#define FPQUEUE_NEW_ELEMENT(self, value_, priority_) \
+    ((FPQUEUE_ELEMENT_TYPE){.priority = (priority_), .value = (value_), .seq = (self)->next_seq++})
+#else
+#define FPQUEUE_ELEMENT_IS_LESS(a, b)                PRIORITY_IS_LESS((a).priority, (b).priority)
+#define FPQUEUE_NEW_ELEMENT(self, value_, priority_) ((FPQUEUE_ELEMENT_TYPE){.priority = (priority_), .value = (value_)})
+#endif
 /// @endcond
 
 // }}}
@@ -146,16 +244,22 @@
  * @brief Generated priority queue element struct type for a given `VALUE_TYPE`.
  */
 struct JOIN(FPQUEUE_NAME, element) {
-    uint32_t priority; ///< Element priority (highest is next to-be-popped).
-    VALUE_TYPE value;  ///< Element value member.
+    PRIORITY_TYPE priority; ///< Element priority (highest is next to-be-popped).
+    VALUE_TYPE value;       ///< Element value member.
+#ifdef FPQUEUE_STABLE
+    uint64_t seq; ///< Insertion sequence number. Set by the priority queue.
+#endif
 };
 
 /**
  * @brief Generated priority queue struct type for a given `VALUE_TYPE`.
  */
 struct FPQUEUE_NAME {
-    uint32_t count;                  ///< Number of non-empty elements.
-    uint32_t capacity;               ///< Number of elements allocated for.
+    uint32_t count;    ///< Number of non-empty elements.
+    uint32_t capacity; ///< Number of elements allocated for.
+#ifdef FPQUEUE_STABLE
+    uint64_t next_seq; ///< Sequence number of the next pushed element.
+#endif
     FPQUEUE_ELEMENT_TYPE elements[]; ///< Array of elements.
 };
 
@@ -165,11 +269,22 @@ struct FPQUEUE_NAME {
 
 /// @cond DO_NOT_DOCUMENT
 
-/* push a node down the heap. for restoring the heap property after insertion */
-static inline void JOIN(internal, JOIN(FPQUEUE_NAME, downheap))(FPQUEUE_TYPE *self, const uint32_t index);
+/* move a hole at index down the heap, and place the element where it stops. for restoring the heap property after
+ * deletion */
+static inline void JOIN(internal, JOIN(FPQUEUE_NAME, downheap))(FPQUEUE_TYPE *self, uint32_t index,
+                                                                const FPQUEUE_ELEMENT_TYPE element);
+
+/* move a hole at index up the heap, and place the element where it stops. for restoring the heap property after
+ * insertion */
+static inline void JOIN(internal, JOIN(FPQUEUE_NAME, upheap))(FPQUEUE_TYPE *self, uint32_t index,
+                                                              const FPQUEUE_ELEMENT_TYPE element);
+
+/* restore the heap property of all elements in O(n), by moving every parent down the heap from the last one */
+static inline void JOIN(internal, JOIN(FPQUEUE_NAME, heapify))(FPQUEUE_TYPE *self);
 
-/* push a node up the heap. for restoring the heap property after deletion */
-static inline void JOIN(internal, JOIN(FPQUEUE_NAME, upheap))(FPQUEUE_TYPE *self, uint32_t index);
+/* get the index of the child with the highest priority, given an index with at least one child */
+static inline uint32_t JOIN(internal, JOIN(FPQUEUE_NAME, largest_child))(const FPQUEUE_TYPE *self,
+                                                                         const uint32_t index);
 
 /// @endcond
 
@@ -185,6 +300,9 @@ static inline FPQUEUE_TYPE *JOIN(FPQUEUE_NAME, init)(FPQUEUE_TYPE *self, const u
 
     self->count = 0;
     self->capacity = capacity;
+#ifdef FPQUEUE_STABLE
+    self->next_seq = 0;
+#endif
 
     return self;
 }
@@ -218,6 +336,48 @@ static inline FPQUEUE_TYPE *JOIN(FPQUEUE_NAME, create)(const uint32_t capacity)
     return self;
 }
 
+/**
+ * @brief Create an priority queue struct with malloc(), and fill it with a
+ *        given array of elements in O(n) time.
+ *
+ * @param[in] capacity          Maximum number of elements expected to be stored.
+ * @param[in] elements          Array of (priority, value) elements. Not required to be ordered.
+ * @param[in] count             Number of elements in the array.
+ *
+ * @return                      A pointer to the priority queue.
+ * @retval NULL
+ *   @li                        If capacity is 0 or less than count or the equivalent size overflows.
+ *   @li                        If malloc fails.
+ */
+static inline FPQUEUE_TYPE *JOIN(FPQUEUE_NAME, create_from_array)(const uint32_t capacity,
+                                                                 const FPQUEUE_ELEMENT_TYPE *elements,
+                                                                 const uint32_t count)
+{
+    assert(elements != NULL || count == 0);
+
+    if (capacity < count) {
+        return NULL;
+    }
+
+    FPQUEUE_TYPE *self = FPQUEUE_CREATE(capacity);
+
+    if (!self) {
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        self->elements[i] = elements[i];
+#ifdef FPQUEUE_STABLE
+        self->elements[i].seq = self->next_seq++;
+#endif
+    }
+    self->count = count;
+
+    FPQUEUE_HEAPIFY(self);
+
+    return self;
+}
+
 /**
  * @brief Destroy an priority queue struct and free the underlying memory with free().
  *
@@ -291,6 +451,11 @@ static inline VALUE_TYPE JOIN(FPQUEUE_NAME, peek)(const FPQUEUE_TYPE *self)
 /**
  * @brief Pop the max priority value away from a non-empty priority queue.
  *
+ * The hole left by the max element is moved down to a leaf along the path of
+ * largest children, without comparing against the last element. The last
+ * element is then moved up from there. Since the last element usually belongs
+ * near the bottom, this saves about half of the comparisons.
+ *
  * @param[in] self              The priority queue pointer.
  *
  * @return                      The max value.
@@ -300,13 +465,25 @@ static inline VALUE_TYPE JOIN(FPQUEUE_NAME, pop_max)(FPQUEUE_TYPE *self)
     assert(self != NULL);
     assert(FPQUEUE_IS_EMPTY(self) == false);
 
-    VALUE_TYPE max_priority_value = self->elements[0].value;
-
-    self->elements[0] = self->elements[self->count - 1];
+    VALUE_TYPE const max_priority_value = self->elements[0].value;
 
     self->count--;
 
-    JOIN(internal, JOIN(FPQUEUE_NAME, downheap))(self, 0);
+    if (self->count == 0) {
+        return max_priority_value;
+    }
+
+    const uint32_t parent_count = (self->count + ARITY - 2) / ARITY;
+
+    uint32_t index = 0;
+    while (index < parent_count) {
+        const uint32_t largest = FPQUEUE_LARGEST_CHILD(self, index);
+
+        self->elements[index] = self->elements[largest];
+        index = largest;
+    }
+
+    FPQUEUE_UPHEAP(self, index, self->elements[self->count]);
 
     return max_priority_value;
 }
@@ -317,20 +494,168 @@ static inline VALUE_TYPE JOIN(FPQUEUE_NAME, pop_max)(FPQUEUE_TYPE *self)
  * @param[in] self              The priority queue pointer.
  * @param[in] value             The value.
  * @param[in] priority          The priority (with large number meaning high
- *                              priority and vice versa).
+ *                              priority and vice versa, unless `PRIORITY_IS_LESS`
+ *                              is defined otherwise).
  */
-static inline void JOIN(FPQUEUE_NAME, push)(FPQUEUE_TYPE *self, VALUE_TYPE value, uint32_t priority)
+static inline void JOIN(FPQUEUE_NAME, push)(FPQUEUE_TYPE *self, VALUE_TYPE value, PRIORITY_TYPE priority)
 {
     assert(self != NULL);
     assert(FPQUEUE_IS_FULL(self) == false);
 
     const uint32_t index = self->count;
 
-    self->elements[index] = (FPQUEUE_ELEMENT_TYPE){.priority = priority, .value = value};
-
     self->count++;
 
-    JOIN(internal, JOIN(FPQUEUE_NAME, upheap))(self, index);
+    FPQUEUE_UPHEAP(self, index, FPQUEUE_NEW_ELEMENT(self, value, priority));
+}
+
+/**
+ * @brief Push an array of elements into the priority queue.
+ *
+ * The elements are either pushed one by one, or appended and the whole heap is
+ * rebuilt in O(n) time, whichever is estimated to be cheaper. Rebuilding is
+ * chosen when the number of elements pushed is large relative to the number of
+ * elements already in the priority queue.
+ *
+ * @param[in] self              The priority queue pointer.
+ * @param[in] elements          Array of (priority, value) elements. Not required to be ordered.
+ * @param[in] count             Number of elements in the array.
+ */
+static inline void JOIN(FPQUEUE_NAME, push_n)(FPQUEUE_TYPE *self, const FPQUEUE_ELEMENT_TYPE *elements,
+                                              const uint32_t count)
+{
+    assert(self != NULL);
+    assert(elements != NULL || count == 0);
+    assert(count <= self->capacity - self->count);
+
+    /* pushing one by one costs up to log2 of the final count per element, rebuilding about 2 * the final count */
+    const uint64_t new_count = (uint64_t)self->count + count;
+
+    uint32_t log2_new_count = 0;
+    for (uint64_t n = new_count; n > 1; n >>= 1) {
+        log2_new_count++;
+    }
+
+    const bool rebuild = 2 * new_count < (uint64_t)count * log2_new_count;
+
+    if (rebuild) {
+        for (uint32_t i = 0; i < count; i++) {
+            self->elements[self->count + i] = elements[i];
+#ifdef FPQUEUE_STABLE
+            self->elements[self->count + i].seq = self->next_seq++;
+#endif
+        }
+        self->count += count;
+
+        FPQUEUE_HEAPIFY(self);
+    }
+    else {
+        for (uint32_t i = 0; i < count; i++) {
+            self->count++;
+
+            FPQUEUE_UPHEAP(self, self->count - 1, FPQUEUE_NEW_ELEMENT(self, elements[i].value, elements[i].priority));
+        }
+    }
+}
+
+/**
+ * @brief Replace the max priority value in a non-empty priority queue with a
+ *        new value and priority.
+ *
+ * Equivalent to a `pop_max` followed by a `push`, but the heap is only walked
+ * down once.
+ *
+ * @param[in] self              The priority queue pointer.
+ * @param[in] value             The new value.
+ * @param[in] priority          The new priority.
+ *
+ * @return                      The replaced max value.
+ */
+static inline VALUE_TYPE JOIN(FPQUEUE_NAME, replace_max)(FPQUEUE_TYPE *self, VALUE_TYPE value,
+                                                         PRIORITY_TYPE priority)
+{
+    assert(self != NULL);
+    assert(FPQUEUE_IS_EMPTY(self) == false);
+
+    VALUE_TYPE const max_priority_value = self->elements[0].value;
+
+    FPQUEUE_DOWNHEAP(self, 0, FPQUEUE_NEW_ELEMENT(self, value, priority));
+
+    return max_priority_value;
+}
+
+/**
+ * @brief Push a value into a bounded priority queue, which keeps the
+ *        `capacity` elements with the lowest priorities.
+ *
+ * If the priority queue is full, the value is rejected with a single
+ * comparison against the max priority, unless it has a lower priority, in which
+ * case it replaces the max element.
+ *
+ * For keeping the top-K elements with the highest priorities (by `<`), create
+ * the priority queue with a capacity of K, and `PRIORITY_IS_LESS` defined as
+ * `(a) > (b)`, and read the result with `drain_sorted`.
+ *
+ * @param[in] self              The priority queue pointer.
+ * @param[in] value             The value.
+ * @param[in] priority          The priority.
+ *
+ * @return                      Whether the value was kept.
+ */
+static inline bool JOIN(FPQUEUE_NAME, push_bounded)(FPQUEUE_TYPE *self, VALUE_TYPE value, PRIORITY_TYPE priority)
+{
+    assert(self != NULL);
+    assert(self->capacity > 0);
+
+    if (FPQUEUE_IS_FULL(self) == false) {
+        JOIN(FPQUEUE_NAME, push)(self, value, priority);
+        return true;
+    }
+
+    const FPQUEUE_ELEMENT_TYPE element = FPQUEUE_NEW_ELEMENT(self, value, priority);
+
+    if (!FPQUEUE_ELEMENT_IS_LESS(element, self->elements[0])) {
+        return false;
+    }
+
+    FPQUEUE_DOWNHEAP(self, 0, element);
+
+    return true;
+}
+
+/**
+ * @brief Empty the priority queue, and sort its elements in place in reverse
+ *        pop order.
+ *
+ * The elements are heap sorted in O(n log n) time with no extra memory. After
+ * the call, `self->elements[0]` has the lowest priority (the last to-be-popped),
+ * and `self->elements[n - 1]` the highest. The elements are left in the array
+ * until the priority queue is pushed to again.
+ *
+ * @param[in] self              The priority queue pointer.
+ *
+ * @return                      The number of sorted elements n.
+ */
+static inline uint32_t JOIN(FPQUEUE_NAME, drain_sorted)(FPQUEUE_TYPE *self)
+{
+    assert(self != NULL);
+
+    const uint32_t count = self->count;
+
+    while (self->count > 1) {
+        const FPQUEUE_ELEMENT_TYPE max_element = self->elements[0];
+
+        self->count--;
+
+        const FPQUEUE_ELEMENT_TYPE last_element = self->elements[self->count];
+        self->elements[self->count] = max_element;
+
+        FPQUEUE_DOWNHEAP(self, 0, last_element);
+    }
+
+    self->count = 0;
+
+    return count;
 }
 
 /**
@@ -363,58 +688,83 @@ static inline void JOIN(FPQUEUE_NAME, copy)(FPQUEUE_TYPE *restrict dest_ptr, con
         dest_ptr->elements[i] = src_ptr->elements[i];
     }
     dest_ptr->count = src_ptr->count;
+#ifdef FPQUEUE_STABLE
+    dest_ptr->next_seq = src_ptr->next_seq;
+#endif
 }
 
 /// @cond DO_NOT_DOCUMENT
 
-static inline void JOIN(internal, JOIN(FPQUEUE_NAME, upheap))(FPQUEUE_TYPE *self, uint32_t index)
+static inline void JOIN(internal, JOIN(FPQUEUE_NAME, upheap))(FPQUEUE_TYPE *self, uint32_t index,
+                                                              const FPQUEUE_ELEMENT_TYPE element)
 {
     assert(self != NULL);
     assert(index < self->count);
 
-    uint32_t parent;
     while (index > 0) {
-        parent = fpqueue_parent(index);
+        const uint32_t parent = FPQUEUE_PARENT(index);
 
-        const bool sorted = self->elements[parent].priority >= self->elements[index].priority;
+        const bool sorted = !FPQUEUE_ELEMENT_IS_LESS(self->elements[parent], element);
 
         if (sorted) {
             break;
         }
 
-        const FPQUEUE_ELEMENT_TYPE temp = self->elements[index];
         self->elements[index] = self->elements[parent];
-        self->elements[parent] = temp;
-
         index = parent;
     }
+
+    self->elements[index] = element;
 }
 
-static inline void JOIN(internal, JOIN(FPQUEUE_NAME, downheap))(FPQUEUE_TYPE *self, const uint32_t index)
+static inline void JOIN(internal, JOIN(FPQUEUE_NAME, downheap))(FPQUEUE_TYPE *self, uint32_t index,
+                                                                const FPQUEUE_ELEMENT_TYPE element)
 {
     assert(self != NULL);
-    assert(self->count == 0 || index < self->count);
+    assert(index < self->count);
 
-    const uint32_t l = fpqueue_left_child(index);
-    const uint32_t r = fpqueue_right_child(index);
+    const uint32_t parent_count = (self->count + ARITY - 2) / ARITY;
 
-    uint32_t largest = index;
-    if (l < self->count && self->elements[l].priority > self->elements[index].priority) {
-        largest = l;
-    }
-    if (r < self->count && self->elements[r].priority > self->elements[largest].priority) {
-        largest = r;
+    while (index < parent_count) {
+        const uint32_t largest = FPQUEUE_LARGEST_CHILD(self, index);
+
+        const bool sorted = !FPQUEUE_ELEMENT_IS_LESS(element, self->elements[largest]);
+
+        if (sorted) {
+            break;
+        }
+
+        self->elements[index] = self->elements[largest];
+        index = largest;
     }
 
-    if (largest == index) {
-        return;
+    self->elements[index] = element;
+}
+
+static inline void JOIN(internal, JOIN(FPQUEUE_NAME, heapify))(FPQUEUE_TYPE *self)
+{
+    assert(self != NULL);
+
+    const uint32_t parent_count = (self->count + ARITY - 2) / ARITY;
+
+    for (uint32_t index = parent_count; index-- > 0;) {
+        FPQUEUE_DOWNHEAP(self, index, self->elements[index]);
     }
+}
 
-    const FPQUEUE_ELEMENT_TYPE temp = self->elements[index];
-    self->elements[index] = self->elements[largest];
-    self->elements[largest] = temp;
+static inline uint32_t JOIN(internal, JOIN(FPQUEUE_NAME, largest_child))(const FPQUEUE_TYPE *self,
+                                                                         const uint32_t index)
+{
+    const uint32_t first_child = FPQUEUE_FIRST_CHILD(index);
+    const uint32_t end_child = self->count - first_child > ARITY ? first_child + ARITY : self->count;
 
-    JOIN(internal, JOIN(FPQUEUE_NAME, downheap))(self, largest);
+    uint32_t largest = first_child;
+    for (uint32_t child = first_child + 1; child < end_child; child++) {
+        if (FPQUEUE_ELEMENT_IS_LESS(self->elements[largest], self->elements[child])) {
+            largest = child;
+        }
+    }
+    return largest;
 }
 /// @endcond
 
@@ -424,16 +774,28 @@ static inline void JOIN(internal, JOIN(FPQUEUE_NAME, downheap))(FPQUEUE_TYPE *se
 
 #undef NAME
 #undef VALUE_TYPE
+#undef ARITY
+#undef PRIORITY_TYPE
+#undef PRIORITY_IS_LESS
+#undef STABLE
 
 #undef FPQUEUE_NAME
 #undef FPQUEUE_TYPE
 #undef FPQUEUE_ELEMENT_TYPE
 #undef FPQUEUE_INIT
+#undef FPQUEUE_CREATE
 #undef FPQUEUE_IS_EMPTY
 #undef FPQUEUE_IS_FULL
 #undef FPQUEUE_CALC_SIZEOF
-#undef FHASHTABLE_UPHEAP
-#undef FHASHTABLE_DOWNHEAP
+#undef FPQUEUE_UPHEAP
+#undef FPQUEUE_DOWNHEAP
+#undef FPQUEUE_HEAPIFY
+#undef FPQUEUE_LARGEST_CHILD
+#undef FPQUEUE_FIRST_CHILD
+#undef FPQUEUE_PARENT
+#undef FPQUEUE_STABLE
+#undef FPQUEUE_ELEMENT_IS_LESS
+#undef FPQUEUE_NEW_ELEMENT
 
 // }}}
 
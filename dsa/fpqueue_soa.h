@@ -0,0 +1,448 @@
+/*  fpqueue_soa.h
+ *
+ *  Copyright (C) 2023 abxh
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *  See the file LICENSE included with this distribution for more
+ *  information. */
+
+/**
+ * @file fpqueue_soa.h
+ * @brief Fixed-size priority queue based on d-ary (max-)heap, with priorities
+ *        and values stored in separate arrays.
+ *
+ * A variant of `fpqueue.h` for large `VALUE_TYPE`s. The heap only consists of
+ * `uint32_t` priorities and `uint32_t` slot indicies, stored in two dense
+ * arrays. Values are stored in a third array indexed by slot, and are never
+ * moved while they are in the heap. A value is copied once on `push` and once
+ * on `pop_max`.
+ *
+ * The children of a node are stored contiguously and aligned, such that the
+ * max child is selected with SIMD instructions when available (SSE4.1 for
+ * `ARITY` 4, AVX2 for `ARITY` 8). Otherwise a scalar loop is used.
+ *
+ * The following macros must be defined:
+ *  @li `NAME`
+ *  @li `VALUE_TYPE`
+ *
+ * The following macros can be defined:
+ *  @li `ARITY`
+ *
+ * Sources used:
+ * @li https://en.wikipedia.org/wiki/D-ary_heap
+ * @li https://en.wikipedia.org/wiki/AoS_and_SoA
+ */
+
+// macro definitions: {{{
+
+#ifndef FPQUEUE_SOA_H
+#define FPQUEUE_SOA_H
+
+#include "align.h"   // calc_alignment_padding
+#include "paste.h"   // PASTE, XPASTE, JOIN
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @def FPQUEUE_SOA_ALIGNMENT
+ * @brief Alignment of the priority array.
+ */
+#define FPQUEUE_SOA_ALIGNMENT (64U)
+
+#endif // FPQUEUE_SOA_H
+
+/**
+ * @def NAME
+ * @brief Prefix to priority queue types and operations. This must be manually
+ *        defined before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef NAME
+#define NAME fpqueue_soa
+#error "Must define NAME."
+#else
+#define FPQUEUE_SOA_NAME NAME
+#endif
+
+/**
+ * @def VALUE_TYPE
+ * @brief Priority queue value type. This must be manually defined before
+ *        including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef VALUE_TYPE
+#error "Must declare VALUE_TYPE."
+#define VALUE_TYPE int
+#endif
+
+/**
+ * @def ARITY
+ * @brief Number of children per node in the heap. Defaults to 8, such that the
+ *        priorities of the children fill 32 bytes.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef ARITY
+#define ARITY 8
+#endif
+
+static_assert(ARITY >= 2, "ARITY must be at least 2.");
+
+/// @cond DO_NOT_DOCUMENT
+#define FPQUEUE_SOA_TYPE          struct FPQUEUE_SOA_NAME
+#define FPQUEUE_SOA_IS_EMPTY      JOIN(FPQUEUE_SOA_NAME, is_empty)
+#define FPQUEUE_SOA_IS_FULL       JOIN(FPQUEUE_SOA_NAME, is_full)
+#define FPQUEUE_SOA_UPHEAP        JOIN(internal, JOIN(FPQUEUE_SOA_NAME, upheap))
+#define FPQUEUE_SOA_LARGEST_CHILD JOIN(internal, JOIN(FPQUEUE_SOA_NAME, largest_child))
+
+#define FPQUEUE_SOA_FIRST_CHILD(index) ((ARITY) * (index) + 1)
+#define FPQUEUE_SOA_PARENT(index)      (((index) - 1) / (ARITY))
+
+/* the priority array is offset by ARITY - 1, such that the children of a node start at a multiple of ARITY */
+#define FPQUEUE_SOA_PRIORITY_OFFSET (ARITY - 1)
+/// @endcond
+
+// }}}
+
+// type definitions: {{{
+
+/**
+ * @brief Generated priority queue struct type for a given `VALUE_TYPE`.
+ *
+ * The priorities past `count` are kept zero, such that the children of the
+ * last parent can be compared without bounds checks.
+ */
+struct FPQUEUE_SOA_NAME {
+    uint32_t count;       ///< Number of non-empty elements.
+    uint32_t capacity;    ///< Number of elements allocated for.
+    uint32_t *priorities; ///< Array of element priorities in heap order.
+    uint32_t *slots;      ///< Array of element value slots in heap order. Free slots are stored past `count`.
+    VALUE_TYPE *values;   ///< Array of values indexed by slot.
+};
+
+// }}}
+
+// function definitions: {{{
+
+/// @cond DO_NOT_DOCUMENT
+
+/* move a hole at index up the heap, and place the (priority, slot) pair where it stops */
+static inline void JOIN(internal, JOIN(FPQUEUE_SOA_NAME, upheap))(FPQUEUE_SOA_TYPE *self, uint32_t index,
+                                                                  const uint32_t priority, const uint32_t slot);
+
+/* get the index of the child with the largest priority, given an index with at least one child */
+static inline uint32_t JOIN(internal, JOIN(FPQUEUE_SOA_NAME, largest_child))(const FPQUEUE_SOA_TYPE *self,
+                                                                             const uint32_t index);
+
+/// @endcond
+
+/**
+ * @brief Create an priority queue struct with a given capacity with
+ *        aligned_alloc().
+ *
+ * @param[in] capacity          Maximum number of elements expected to be stored.
+ *
+ * @return                      A pointer to the priority queue.
+ * @retval NULL
+ *   @li                        If capacity is 0 or larger than UINT32_MAX / 4.
+ *   @li                        If the equivalent size overflows.
+ *   @li                        If aligned_alloc fails.
+ */
+static inline FPQUEUE_SOA_TYPE *JOIN(FPQUEUE_SOA_NAME, create)(const uint32_t capacity)
+{
+    if (capacity == 0 || capacity > UINT32_MAX / 4) {
+        return NULL;
+    }
+
+    const size_t priorities_count = FPQUEUE_SOA_PRIORITY_OFFSET + (size_t)capacity + ARITY;
+
+    size_t size = sizeof(FPQUEUE_SOA_TYPE);
+    size += calc_alignment_padding(FPQUEUE_SOA_ALIGNMENT, size);
+
+    const size_t priorities_offset = size;
+    size += priorities_count * sizeof(uint32_t);
+
+    const size_t slots_offset = size;
+    size += (size_t)capacity * sizeof(uint32_t);
+    size += calc_alignment_padding(alignof(VALUE_TYPE), size);
+
+    if ((SIZE_MAX - size) / sizeof(VALUE_TYPE) < capacity) {
+        return NULL;
+    }
+
+    const size_t values_offset = size;
+    size += (size_t)capacity * sizeof(VALUE_TYPE);
+    size += calc_alignment_padding(FPQUEUE_SOA_ALIGNMENT, size);
+
+    unsigned char *ptr = (unsigned char *)aligned_alloc(FPQUEUE_SOA_ALIGNMENT, size);
+
+    if (!ptr) {
+        return NULL;
+    }
+
+    FPQUEUE_SOA_TYPE *self = (FPQUEUE_SOA_TYPE *)ptr;
+
+    self->count = 0;
+    self->capacity = capacity;
+    self->priorities = (uint32_t *)&ptr[priorities_offset] + FPQUEUE_SOA_PRIORITY_OFFSET;
+    self->slots = (uint32_t *)&ptr[slots_offset];
+    self->values = (VALUE_TYPE *)&ptr[values_offset];
+
+    memset(&ptr[priorities_offset], 0, priorities_count * sizeof(uint32_t));
+
+    for (uint32_t i = 0; i < capacity; i++) {
+        self->slots[i] = i;
+    }
+
+    return self;
+}
+
+/**
+ * @brief Destroy an priority queue struct and free the underlying memory with free().
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The priority queue pointer.
+ */
+static inline void JOIN(FPQUEUE_SOA_NAME, destroy)(FPQUEUE_SOA_TYPE *self)
+{
+    assert(self != NULL);
+
+    free(self);
+}
+
+/**
+ * @brief Return whether the priority queue is empty.
+ *
+ * @param[in] self              The priority queue pointer.
+ *
+ * @return                      Whether the priority queue is empty.
+ */
+static inline bool JOIN(FPQUEUE_SOA_NAME, is_empty)(const FPQUEUE_SOA_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == 0;
+}
+
+/**
+ * @brief Return whether the priority queue is full.
+ *
+ * @param[in] self              The priority queue pointer.
+ *
+ * @return                      Whether the priority queue is full.
+ */
+static inline bool JOIN(FPQUEUE_SOA_NAME, is_full)(const FPQUEUE_SOA_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == self->capacity;
+}
+
+/**
+ * @brief Get the max priority value in a non-empty priority queue.
+ *
+ * @param[in] self              The priority queue pointer.
+ *
+ * @return                      The max priority value.
+ */
+static inline VALUE_TYPE JOIN(FPQUEUE_SOA_NAME, get_max)(const FPQUEUE_SOA_TYPE *self)
+{
+    assert(self != NULL);
+    assert(FPQUEUE_SOA_IS_EMPTY(self) == false);
+
+    return self->values[self->slots[0]];
+}
+
+/**
+ * @brief Peek a non-empty priority queue and get it's next to-be-popped (max priority)
+ *        value.
+ *
+ * @param[in] self              The priority queue pointer.
+ *
+ * @return                      The next to-be-popped (max priority) value.
+ */
+static inline VALUE_TYPE JOIN(FPQUEUE_SOA_NAME, peek)(const FPQUEUE_SOA_TYPE *self)
+{
+    return JOIN(FPQUEUE_SOA_NAME, get_max)(self);
+}
+
+/**
+ * @brief Pop the max priority value away from a non-empty priority queue.
+ *
+ * The hole left by the max element is moved down to a leaf along the path of
+ * largest children, after which the last element is moved up from there.
+ *
+ * @param[in] self              The priority queue pointer.
+ *
+ * @return                      The max value.
+ */
+static inline VALUE_TYPE JOIN(FPQUEUE_SOA_NAME, pop_max)(FPQUEUE_SOA_TYPE *self)
+{
+    assert(self != NULL);
+    assert(FPQUEUE_SOA_IS_EMPTY(self) == false);
+
+    const uint32_t max_slot = self->slots[0];
+
+    self->count--;
+
+    const uint32_t last_priority = self->priorities[self->count];
+    const uint32_t last_slot = self->slots[self->count];
+
+    self->priorities[self->count] = 0;
+    self->slots[self->count] = max_slot;
+
+    if (self->count > 0) {
+        const uint32_t parent_count = (self->count + ARITY - 2) / ARITY;
+
+        uint32_t index = 0;
+        while (index < parent_count) {
+            const uint32_t largest = FPQUEUE_SOA_LARGEST_CHILD(self, index);
+
+            self->priorities[index] = self->priorities[largest];
+            self->slots[index] = self->slots[largest];
+            index = largest;
+        }
+
+        FPQUEUE_SOA_UPHEAP(self, index, last_priority, last_slot);
+    }
+
+    return self->values[max_slot];
+}
+
+/**
+ * @brief Push a value with given priority onto a non-full priority queue.
+ *
+ * @param[in] self              The priority queue pointer.
+ * @param[in] value             The value.
+ * @param[in] priority          The priority (with large number meaning high
+ *                              priority and vice versa).
+ */
+static inline void JOIN(FPQUEUE_SOA_NAME, push)(FPQUEUE_SOA_TYPE *self, VALUE_TYPE value, uint32_t priority)
+{
+    assert(self != NULL);
+    assert(FPQUEUE_SOA_IS_FULL(self) == false);
+
+    const uint32_t index = self->count;
+    const uint32_t slot = self->slots[index];
+
+    self->values[slot] = value;
+
+    self->count++;
+
+    FPQUEUE_SOA_UPHEAP(self, index, priority, slot);
+}
+
+/**
+ * @brief Clear the elements in the priority queue.
+ *
+ * @param[in] self              The priority queue pointer.
+ */
+static inline void JOIN(FPQUEUE_SOA_NAME, clear)(FPQUEUE_SOA_TYPE *self)
+{
+    assert(self != NULL);
+
+    memset(self->priorities, 0, self->count * sizeof(uint32_t));
+
+    self->count = 0;
+}
+
+/// @cond DO_NOT_DOCUMENT
+
+static inline void JOIN(internal, JOIN(FPQUEUE_SOA_NAME, upheap))(FPQUEUE_SOA_TYPE *self, uint32_t index,
+                                                                  const uint32_t priority, const uint32_t slot)
+{
+    assert(self != NULL);
+    assert(index < self->count);
+
+    while (index > 0) {
+        const uint32_t parent = FPQUEUE_SOA_PARENT(index);
+
+        const bool sorted = self->priorities[parent] >= priority;
+
+        if (sorted) {
+            break;
+        }
+
+        self->priorities[index] = self->priorities[parent];
+        self->slots[index] = self->slots[parent];
+        index = parent;
+    }
+
+    self->priorities[index] = priority;
+    self->slots[index] = slot;
+}
+
+static inline uint32_t JOIN(internal, JOIN(FPQUEUE_SOA_NAME, largest_child))(const FPQUEUE_SOA_TYPE *self,
+                                                                             const uint32_t index)
+{
+    const uint32_t first_child = FPQUEUE_SOA_FIRST_CHILD(index);
+    const uint32_t *children = &self->priorities[first_child];
+
+#if ARITY == 8 && defined(__AVX2__)
+    const __m256i v = _mm256_loadu_si256((const __m256i *)children);
+
+    __m256i m = _mm256_max_epu32(v, _mm256_permute2x128_si256(v, v, 0x01));
+    m = _mm256_max_epu32(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm256_max_epu32(m, _mm256_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    const uint32_t mask = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, m)));
+
+    return first_child + (uint32_t)__builtin_ctz(mask);
+#elif ARITY == 4 && defined(__SSE4_1__)
+    const __m128i v = _mm_loadu_si128((const __m128i *)children);
+
+    __m128i m = _mm_max_epu32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm_max_epu32(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    const uint32_t mask = (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, m)));
+
+    return first_child + (uint32_t)__builtin_ctz(mask);
+#else
+    /* the priorities past count are zero, so all ARITY children can be compared. ties go to the first child */
+    uint32_t largest = 0;
+    for (uint32_t i = 1; i < ARITY; i++) {
+        largest = children[i] > children[largest] ? i : largest;
+    }
+    return first_child + largest;
+#endif
+}
+
+/// @endcond
+
+// }}}
+
+// macro undefs: {{{
+
+#undef NAME
+#undef VALUE_TYPE
+#undef ARITY
+
+#undef FPQUEUE_SOA_NAME
+#undef FPQUEUE_SOA_TYPE
+#undef FPQUEUE_SOA_IS_EMPTY
+#undef FPQUEUE_SOA_IS_FULL
+#undef FPQUEUE_SOA_UPHEAP
+#undef FPQUEUE_SOA_LARGEST_CHILD
+#undef FPQUEUE_SOA_FIRST_CHILD
+#undef FPQUEUE_SOA_PARENT
+#undef FPQUEUE_SOA_PRIORITY_OFFSET
+
+// }}}
+
+// vim: ft=c fdm=marker
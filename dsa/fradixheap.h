@@ -0,0 +1,480 @@
+/*  fradixheap.h
+ *
+ *  Copyright (C) 2023 abxh
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *  See the file LICENSE included with this distribution for more
+ *  information. */
+
+/**
+ * @file fradixheap.h
+ * @brief Fixed-size radix heap for monotone integer keys.
+ *
+ * A min-priority queue with the restriction that a pushed key may not be less
+ * than the last popped key, e.g. timestamps in an event loop.
+ *
+ * Elements are kept in `KEY_BITS + 1` buckets, where bucket `i > 0` holds the
+ * keys whose highest bit differing from the last popped key is bit `i - 1`,
+ * and bucket 0 holds the keys equal to it. When bucket 0 is empty, the min of
+ * the first non-empty bucket becomes the new last key, and the elements of
+ * that bucket are redistributed into lower buckets. Every element moves down
+ * at most `KEY_BITS` times, such that `push` is O(1) and `pop_min` is amortized
+ * O(`KEY_BITS`).
+ *
+ * Buckets are singly linked lists of elements in a fixed-size pool, such that
+ * no memory is allocated after creation. Since redistributing a bucket chases
+ * its links, `fpqueue.h` may be faster for heaps of around a million elements.
+ *
+ * The following macros must be defined:
+ *  @li `NAME`
+ *  @li `VALUE_TYPE`
+ *
+ * The following macros can be defined:
+ *  @li `KEY_TYPE`
+ *
+ * Sources used:
+ * @li https://en.wikipedia.org/wiki/Radix_heap
+ * @li http://ssp.impulsetrain.com/radix-heap.html
+ */
+
+// macro definitions: {{{
+
+#ifndef FRADIXHEAP_H
+#define FRADIXHEAP_H
+
+#include "paste.h" // PASTE, XPASTE, JOIN
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * @def FRADIXHEAP_NIL
+ * @brief Index used to mark the end of a bucket or the free list.
+ */
+#define FRADIXHEAP_NIL (UINT32_MAX)
+
+/**
+ * @def fradixheap_calc_sizeof(fradixheap_name, capacity)
+ *
+ * @brief Calculate the size of the heap struct. No overflow checks.
+ *
+ * @param[in] fradixheap_name   Defined heap NAME.
+ * @param[in] capacity          Capacity input.
+ *
+ * @return                      The equivalent size.
+ */
+#define fradixheap_calc_sizeof(fradixheap_name, capacity) \
+    (uint32_t)(offsetof(struct fradixheap_name, elements)  \
+               + capacity * sizeof(((struct fradixheap_name *)0)->elements[0]))
+
+/**
+ * @def fradixheap_calc_sizeof_overflows(fradixheap_name, capacity)
+ *
+ * @brief Check for a given capacity, if the equivalent size of the heap struct overflows.
+ *
+ * @param[in] fradixheap_name   Defined heap NAME.
+ * @param[in] capacity          Capacity input.
+ *
+ * @return                      Whether the equivalent size overflows.
+ */
+#define fradixheap_calc_sizeof_overflows(fradixheap_name, capacity)         \
+    (capacity > (UINT32_MAX - offsetof(struct fradixheap_name, elements)) \
+                    / sizeof(((struct fradixheap_name *)0)->elements[0]))
+
+/// @cond DO_NOT_DOCUMENT
+/* number of bits needed to represent x. 0 for x = 0 */
+static inline uint32_t internal_fradixheap_bit_length(const uint64_t x)
+{
+// Test for GCC >= 3.4.0
+#if defined(__GNUC__) && (__GNUC__ > 3 || (__GNUC__ == 3 && (__GNUC_MINOR__ > 4 || __GNUC_MINOR__ == 4)))
+
+    return x == 0 ? 0 : 64U - (uint32_t)__builtin_clzll(x);
+
+#else
+    uint32_t n = 0;
+    for (uint64_t y = x; y != 0; y >>= 1) {
+        n++;
+    }
+    return n;
+#endif
+}
+/// @endcond
+
+#endif // FRADIXHEAP_H
+
+/**
+ * @def NAME
+ * @brief Prefix to heap types and operations. This must be manually defined
+ *        before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef NAME
+#define NAME fradixheap
+#error "Must define NAME."
+#else
+#define FRADIXHEAP_NAME NAME
+#endif
+
+/**
+ * @def VALUE_TYPE
+ * @brief Heap value type. This must be manually defined before including this
+ *        header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef VALUE_TYPE
+#error "Must declare VALUE_TYPE."
+#define VALUE_TYPE int
+#endif
+
+/**
+ * @def KEY_TYPE
+ * @brief Unsigned integer key type. Defaults to `uint32_t`. At most 64 bits.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef KEY_TYPE
+#define KEY_TYPE uint32_t
+#endif
+
+static_assert((KEY_TYPE)-1 > 0 && sizeof(KEY_TYPE) <= sizeof(uint64_t), "KEY_TYPE must be unsigned, and at most 64 bits.");
+
+/// @cond DO_NOT_DOCUMENT
+#define FRADIXHEAP_TYPE         struct FRADIXHEAP_NAME
+#define FRADIXHEAP_ELEMENT_TYPE struct JOIN(FRADIXHEAP_NAME, element)
+#define FRADIXHEAP_INIT         JOIN(FRADIXHEAP_NAME, init)
+#define FRADIXHEAP_IS_EMPTY     JOIN(FRADIXHEAP_NAME, is_empty)
+#define FRADIXHEAP_IS_FULL      JOIN(FRADIXHEAP_NAME, is_full)
+#define FRADIXHEAP_INSERT       JOIN(internal, JOIN(FRADIXHEAP_NAME, insert))
+#define FRADIXHEAP_REFILL       JOIN(internal, JOIN(FRADIXHEAP_NAME, refill))
+
+#define FRADIXHEAP_KEY_BITS     (8 * sizeof(KEY_TYPE))
+#define FRADIXHEAP_BUCKET_COUNT (FRADIXHEAP_KEY_BITS + 1)
+/// @endcond
+
+// }}}
+
+// type definitions: {{{
+
+/**
+ * @brief Generated heap element struct type for a given `VALUE_TYPE`.
+ */
+struct JOIN(FRADIXHEAP_NAME, element) {
+    KEY_TYPE key;     ///< Element key (lowest is next to-be-popped).
+    uint32_t next;    ///< Index of the next element in the same bucket, or in the free list.
+    VALUE_TYPE value; ///< Element value member.
+};
+
+/**
+ * @brief Generated heap struct type for a given `VALUE_TYPE`.
+ */
+struct FRADIXHEAP_NAME {
+    uint32_t count;                                   ///< Number of non-empty elements.
+    uint32_t capacity;                                ///< Number of elements allocated for.
+    KEY_TYPE last_key;                                ///< Last popped key. Pushed keys may not be less.
+    uint32_t free_head;                               ///< Index of the first free element.
+    uint32_t bucket_heads[FRADIXHEAP_BUCKET_COUNT];   ///< Index of the first element in each bucket.
+    KEY_TYPE bucket_min_keys[FRADIXHEAP_BUCKET_COUNT]; ///< Min key in each non-empty bucket.
+    FRADIXHEAP_ELEMENT_TYPE elements[];               ///< Pool of elements.
+};
+
+// }}}
+
+// function definitions: {{{
+
+/// @cond DO_NOT_DOCUMENT
+
+/* link an element into the bucket given by its key */
+static inline void JOIN(internal, JOIN(FRADIXHEAP_NAME, insert))(FRADIXHEAP_TYPE *self, const uint32_t index);
+
+/* make the min of the first non-empty bucket the last key, and redistribute that bucket, given an empty bucket 0 */
+static inline void JOIN(internal, JOIN(FRADIXHEAP_NAME, refill))(FRADIXHEAP_TYPE *self);
+
+/// @endcond
+
+/**
+ * @brief Initialize a heap struct, given a capacity.
+ *
+ * @param[in] self              Heap pointer
+ * @param[in] capacity          Capacity
+ */
+static inline FRADIXHEAP_TYPE *JOIN(FRADIXHEAP_NAME, init)(FRADIXHEAP_TYPE *self, const uint32_t capacity)
+{
+    assert(self);
+
+    self->count = 0;
+    self->capacity = capacity;
+    self->last_key = 0;
+    self->free_head = 0;
+
+    for (uint32_t i = 0; i < FRADIXHEAP_BUCKET_COUNT; i++) {
+        self->bucket_heads[i] = FRADIXHEAP_NIL;
+    }
+    for (uint32_t i = 0; i < capacity; i++) {
+        self->elements[i].next = i + 1 < capacity ? i + 1 : FRADIXHEAP_NIL;
+    }
+
+    return self;
+}
+
+/**
+ * @brief Create an heap struct with a given capacity with malloc().
+ *
+ * @param[in] capacity          Maximum number of elements expected to be stored.
+ *
+ * @return                      A pointer to the heap.
+ * @retval NULL
+ *   @li                        If capacity is 0 or the equivalent size overflows.
+ *   @li                        If malloc fails.
+ */
+static inline FRADIXHEAP_TYPE *JOIN(FRADIXHEAP_NAME, create)(const uint32_t capacity)
+{
+    if (capacity == 0 || fradixheap_calc_sizeof_overflows(FRADIXHEAP_NAME, capacity)) {
+        return NULL;
+    }
+
+    const uint32_t size = fradixheap_calc_sizeof(FRADIXHEAP_NAME, capacity);
+
+    FRADIXHEAP_TYPE *self = (FRADIXHEAP_TYPE *)calloc(1, size);
+
+    if (!self) {
+        return NULL;
+    }
+
+    FRADIXHEAP_INIT(self, capacity);
+
+    return self;
+}
+
+/**
+ * @brief Destroy an heap struct and free the underlying memory with free().
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The heap pointer.
+ */
+static inline void JOIN(FRADIXHEAP_NAME, destroy)(FRADIXHEAP_TYPE *self)
+{
+    assert(self != NULL);
+
+    free(self);
+}
+
+/**
+ * @brief Return whether the heap is empty.
+ *
+ * @param[in] self              The heap pointer.
+ *
+ * @return                      Whether the heap is empty.
+ */
+static inline bool JOIN(FRADIXHEAP_NAME, is_empty)(const FRADIXHEAP_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == 0;
+}
+
+/**
+ * @brief Return whether the heap is full.
+ *
+ * @param[in] self              The heap pointer.
+ *
+ * @return                      Whether the heap is full.
+ */
+static inline bool JOIN(FRADIXHEAP_NAME, is_full)(const FRADIXHEAP_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == self->capacity;
+}
+
+/**
+ * @brief Get the min key in a non-empty heap.
+ *
+ * @note May redistribute a bucket, which is why the heap is not `const`.
+ *
+ * @param[in] self              The heap pointer.
+ *
+ * @return                      The min key.
+ */
+static inline KEY_TYPE JOIN(FRADIXHEAP_NAME, get_min_key)(FRADIXHEAP_TYPE *self)
+{
+    assert(self != NULL);
+    assert(FRADIXHEAP_IS_EMPTY(self) == false);
+
+    if (self->bucket_heads[0] == FRADIXHEAP_NIL) {
+        FRADIXHEAP_REFILL(self);
+    }
+
+    return self->last_key;
+}
+
+/**
+ * @brief Get the min key value in a non-empty heap.
+ *
+ * @note May redistribute a bucket, which is why the heap is not `const`.
+ *
+ * @param[in] self              The heap pointer.
+ *
+ * @return                      The min key value.
+ */
+static inline VALUE_TYPE JOIN(FRADIXHEAP_NAME, get_min)(FRADIXHEAP_TYPE *self)
+{
+    assert(self != NULL);
+    assert(FRADIXHEAP_IS_EMPTY(self) == false);
+
+    if (self->bucket_heads[0] == FRADIXHEAP_NIL) {
+        FRADIXHEAP_REFILL(self);
+    }
+
+    return self->elements[self->bucket_heads[0]].value;
+}
+
+/**
+ * @brief Peek a non-empty heap and get it's next to-be-popped (min key) value.
+ *
+ * @param[in] self              The heap pointer.
+ *
+ * @return                      The next to-be-popped (min key) value.
+ */
+static inline VALUE_TYPE JOIN(FRADIXHEAP_NAME, peek)(FRADIXHEAP_TYPE *self)
+{
+    return JOIN(FRADIXHEAP_NAME, get_min)(self);
+}
+
+/**
+ * @brief Pop the min key value away from a non-empty heap. Values with equal
+ *        keys are popped in no particular order.
+ *
+ * @param[in] self              The heap pointer.
+ *
+ * @return                      The min key value.
+ */
+static inline VALUE_TYPE JOIN(FRADIXHEAP_NAME, pop_min)(FRADIXHEAP_TYPE *self)
+{
+    assert(self != NULL);
+    assert(FRADIXHEAP_IS_EMPTY(self) == false);
+
+    if (self->bucket_heads[0] == FRADIXHEAP_NIL) {
+        FRADIXHEAP_REFILL(self);
+    }
+
+    const uint32_t index = self->bucket_heads[0];
+
+    self->bucket_heads[0] = self->elements[index].next;
+    self->elements[index].next = self->free_head;
+    self->free_head = index;
+    self->count--;
+
+    return self->elements[index].value;
+}
+
+/**
+ * @brief Push a value with a given key onto a non-full heap.
+ *
+ * @param[in] self              The heap pointer.
+ * @param[in] value             The value.
+ * @param[in] key               The key. Must not be less than the last popped key.
+ */
+static inline void JOIN(FRADIXHEAP_NAME, push)(FRADIXHEAP_TYPE *self, VALUE_TYPE value, const KEY_TYPE key)
+{
+    assert(self != NULL);
+    assert(FRADIXHEAP_IS_FULL(self) == false);
+    assert(key >= self->last_key && "key is less than the last popped key!");
+
+    const uint32_t index = self->free_head;
+
+    self->free_head = self->elements[index].next;
+    self->elements[index].key = key;
+    self->elements[index].value = value;
+    self->count++;
+
+    FRADIXHEAP_INSERT(self, index);
+}
+
+/**
+ * @brief Clear the elements in the heap. The last popped key is kept.
+ *
+ * @param[in] self              The heap pointer.
+ */
+static inline void JOIN(FRADIXHEAP_NAME, clear)(FRADIXHEAP_TYPE *self)
+{
+    assert(self != NULL);
+
+    const KEY_TYPE last_key = self->last_key;
+
+    FRADIXHEAP_INIT(self, self->capacity);
+
+    self->last_key = last_key;
+}
+
+/// @cond DO_NOT_DOCUMENT
+
+static inline void JOIN(internal, JOIN(FRADIXHEAP_NAME, insert))(FRADIXHEAP_TYPE *self, const uint32_t index)
+{
+    const KEY_TYPE key = self->elements[index].key;
+    const uint32_t bucket = internal_fradixheap_bit_length((uint64_t)(key ^ self->last_key));
+
+    if (self->bucket_heads[bucket] == FRADIXHEAP_NIL || key < self->bucket_min_keys[bucket]) {
+        self->bucket_min_keys[bucket] = key;
+    }
+
+    self->elements[index].next = self->bucket_heads[bucket];
+    self->bucket_heads[bucket] = index;
+}
+
+static inline void JOIN(internal, JOIN(FRADIXHEAP_NAME, refill))(FRADIXHEAP_TYPE *self)
+{
+    assert(self->bucket_heads[0] == FRADIXHEAP_NIL);
+    assert(self->count > 0);
+
+    uint32_t bucket = 1;
+    while (self->bucket_heads[bucket] == FRADIXHEAP_NIL) {
+        bucket++;
+    }
+
+    uint32_t index = self->bucket_heads[bucket];
+
+    self->last_key = self->bucket_min_keys[bucket];
+    self->bucket_heads[bucket] = FRADIXHEAP_NIL;
+
+    while (index != FRADIXHEAP_NIL) {
+        const uint32_t next = self->elements[index].next;
+
+        FRADIXHEAP_INSERT(self, index);
+
+        index = next;
+    }
+}
+
+/// @endcond
+
+// }}}
+
+// macro undefs: {{{
+
+#undef NAME
+#undef VALUE_TYPE
+#undef KEY_TYPE
+
+#undef FRADIXHEAP_NAME
+#undef FRADIXHEAP_TYPE
+#undef FRADIXHEAP_ELEMENT_TYPE
+#undef FRADIXHEAP_INIT
+#undef FRADIXHEAP_IS_EMPTY
+#undef FRADIXHEAP_IS_FULL
+#undef FRADIXHEAP_INSERT
+#undef FRADIXHEAP_REFILL
+#undef FRADIXHEAP_KEY_BITS
+#undef FRADIXHEAP_BUCKET_COUNT
+
+// }}}
+
+// vim: ft=c fdm=marker
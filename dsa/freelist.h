@@ -31,6 +31,15 @@
 
 #include "align.h" // align, calc_alignment_padding, CALC_ALIGNMENT_PADDING
 
+/**
+ * @def FREELIST_ZERO_MEMORY
+ * @brief Whether `freelist_allocate` zeroes out the returned block. Defaults
+ *        to 0. `freelist_allocate_uninit` never zeroes the block.
+ */
+#ifndef FREELIST_ZERO_MEMORY
+#define FREELIST_ZERO_MEMORY 0
+#endif
+
 /**
  * @brief Freelist header definition. This lies at the front of every block.
  */
@@ -177,8 +186,8 @@ static inline size_t internal_freelist_calc_block_size(size_t requested_size)
 }
 /// @endcond
 
-/* Get the pointer to a block of the freelist.*/
-static inline void *freelist_allocate(struct freelist *self, const size_t requested_size)
+/* Get the pointer to an uninitialized block of the freelist. */
+static inline void *freelist_allocate_uninit(struct freelist *self, const size_t requested_size)
 {
     assert(self);
     assert(requested_size != 0);
@@ -200,6 +209,18 @@ static inline void *freelist_allocate(struct freelist *self, const size_t reques
                                         node->key.curr_block_size - block_size);
 }
 
+/* Get the pointer to a block of the freelist. Zeroed out if FREELIST_ZERO_MEMORY is 1. */
+static inline void *freelist_allocate(struct freelist *self, const size_t requested_size)
+{
+    void *ptr = freelist_allocate_uninit(self, requested_size);
+
+    if (FREELIST_ZERO_MEMORY && ptr != NULL) {
+        memset(ptr, 0, requested_size);
+    }
+
+    return ptr;
+}
+
 /* Deallocate a block from the freelist for further use. */
 static inline void freelist_deallocate(struct freelist *self, void *ptr)
 {
@@ -250,7 +271,7 @@ static inline void *freelist_reallocate(struct freelist *self, void *ptr, const
         return internal_freelist_init_block(self, (char *)header, next, prev_size, new_size, bytes_acc - new_size);
     }
 
-    void *ptr_new = freelist_allocate(self, new_size);
+    void *ptr_new = freelist_allocate_uninit(self, new_size);
     if (!ptr_new) {
         return NULL;
     }
@@ -36,6 +36,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 /**
  * @def fstack_for_each(self, index, value)
@@ -296,7 +297,7 @@ static inline VALUE_TYPE JOIN(FSTACK_NAME, peek)(const FSTACK_TYPE *self)
  * @param[in] self              The stack pointer.
  * @param[in] value             The value.
  */
-static inline void JOIN(FSTACK_NAME, push)(FSTACK_TYPE *self, const VALUE_TYPE value)
+static inline void JOIN(FSTACK_NAME, push)(FSTACK_TYPE *self, VALUE_TYPE const value)
 {
     assert(self != NULL);
     assert(FSTACK_IS_FULL(self) == false);
@@ -319,6 +320,79 @@ static inline VALUE_TYPE JOIN(FSTACK_NAME, pop)(FSTACK_TYPE *self)
     return self->values[--self->count];
 }
 
+/**
+ * @brief Get a pointer to the top values of the stack, ordered from bottom to
+ *        top.
+ *
+ * @warning The pointer is invalidated by the next push / pop.
+ *
+ * @param[in] self              The stack pointer.
+ * @param[in] n                 The number of values. At most `count`.
+ *
+ * @return                      A pointer to the `n` top values, where the top
+ *                              value is at index `n - 1`.
+ */
+static inline VALUE_TYPE const *JOIN(FSTACK_NAME, top_span)(const FSTACK_TYPE *self, const uint32_t n)
+{
+    assert(self != NULL);
+    assert(n <= self->count);
+
+    return &self->values[self->count - n];
+}
+
+/**
+ * @brief Push an array of values onto the stack with a single memcpy().
+ *
+ * Same as pushing `values[0]`, ..., `values[n - 1]` one by one, such that
+ * `values[n - 1]` is placed at the top.
+ *
+ * For runs shorter than ~16 values, the memcpy() call may cost more than
+ * pushing the values one by one.
+ *
+ * @param[in] self              The stack pointer.
+ * @param[in] values            The array of values.
+ * @param[in] n                 The number of values. At most `capacity - count`.
+ */
+static inline void JOIN(FSTACK_NAME, push_n)(FSTACK_TYPE *restrict self, VALUE_TYPE const *restrict values,
+                                             const uint32_t n)
+{
+    assert(self != NULL);
+    assert(values != NULL || n == 0);
+    assert(n <= self->capacity - self->count);
+
+    if (n == 0) {
+        return;
+    }
+
+    memcpy(&self->values[self->count], values, n * sizeof(VALUE_TYPE));
+
+    self->count += n;
+}
+
+/**
+ * @brief Pop the top values away from the stack with a single memcpy().
+ *
+ * The values are copied in the same order as `top_span`, i.e. the reverse of
+ * the order they would be popped one by one, such that `push_n` of the output
+ * restores the stack.
+ *
+ * @param[in] self              The stack pointer.
+ * @param[out] values           The array to copy the values to. May be NULL to
+ *                              discard the values.
+ * @param[in] n                 The number of values. At most `count`.
+ */
+static inline void JOIN(FSTACK_NAME, pop_n)(FSTACK_TYPE *restrict self, VALUE_TYPE *restrict values, const uint32_t n)
+{
+    assert(self != NULL);
+    assert(n <= self->count);
+
+    self->count -= n;
+
+    if (values != NULL && n != 0) {
+        memcpy(values, &self->values[self->count], n * sizeof(VALUE_TYPE));
+    }
+}
+
 /**
  * @brief Clear the elements in the stack.
  *
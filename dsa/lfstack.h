@@ -0,0 +1,241 @@
+/*  lfstack.h
+ *
+ *  Copyright (C) 2023 abxh
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *  See the file LICENSE included with this distribution for more
+ *  information. */
+
+/**
+ * @file lfstack.h
+ * @brief Intrusive lock-free stack (Treiber stack)
+ *
+ * A thread-safe LIFO of `lfstack_node`s embedded in user structs, e.g. a
+ * free-list of pooled objects shared between threads. `push` and `pop` are a
+ * single compare-and-swap on the head in the uncontended case.
+ *
+ * To avoid the ABA problem, the head is a tagged pointer: the node pointer and
+ * a counter, which is incremented on every change of the head, are packed into
+ * a single 64-bit word. A `pop` that has been delayed, while the same node was
+ * popped and pushed back, thus fails its compare-and-swap. On 64-bit platforms,
+ * the node pointer must fit in the lower 48 bits (true for user space on x86-64
+ * and AArch64 with 4-level page tables, and by default with 5-level page
+ * tables on Linux). The upper 16 bits and the low bits, which are zero due to
+ * the alignment of the node, hold the counter, which thus wraps around after
+ * 2^19 changes. The counter would have to wrap around exactly within the delay
+ * of a single `pop` for the ABA problem to occur.
+ *
+ * @warning `pop` may read the `next` member of a node which another thread has
+ *          just popped. Popped nodes may be reused, but their memory must stay
+ *          mapped while the stack is in use, e.g. by being allocated from a
+ *          pool or arena.
+ *
+ * @warning `push` calls abort(), in every build mode, if the node pointer does
+ *          not fit, e.g. if it is mapped above 2^48 or carries hardware tag
+ *          bits in its top byte.
+ *
+ * Sources used:
+ * @li https://en.wikipedia.org/wiki/Treiber_stack
+ * @li https://en.wikipedia.org/wiki/ABA_problem
+ */
+
+#pragma once
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/// @cond DO_NOT_DOCUMENT
+#if UINTPTR_MAX == UINT32_MAX
+#define LFSTACK_POINTER_BITS (32U)
+#define LFSTACK_ALIGN_BITS   (2U)
+#else
+#define LFSTACK_POINTER_BITS (48U)
+#define LFSTACK_ALIGN_BITS   (3U)
+#endif
+
+#define LFSTACK_ALIGN_MASK   (((uint64_t)1 << LFSTACK_ALIGN_BITS) - 1)
+#define LFSTACK_POINTER_MASK ((((uint64_t)1 << LFSTACK_POINTER_BITS) - 1) & ~LFSTACK_ALIGN_MASK)
+/// @endcond
+
+/**
+ * @brief Intrusive stack node struct. Embed it in a struct, and use
+ *        `container_of` to get the struct back.
+ */
+struct lfstack_node {
+    _Atomic(struct lfstack_node *) next; ///< Next node in the stack.
+};
+
+static_assert(alignof(struct lfstack_node) >= (1U << LFSTACK_ALIGN_BITS),
+              "The low bits of a node pointer must be free for the tag.");
+
+/**
+ * @brief Lock-free stack struct.
+ */
+struct lfstack {
+    _Atomic uint64_t head; ///< Tagged pointer to the top node.
+};
+
+/// @cond DO_NOT_DOCUMENT
+/* the node pointer is checked by push, as every other packed pointer has been pushed before */
+static inline uint64_t internal_lfstack_pack(const struct lfstack_node *node, const uint64_t tag)
+{
+    const uint64_t high_tag = (tag >> LFSTACK_ALIGN_BITS) << LFSTACK_POINTER_BITS;
+
+    return high_tag | (uint64_t)(uintptr_t)node | (tag & LFSTACK_ALIGN_MASK);
+}
+
+static inline struct lfstack_node *internal_lfstack_unpack_node(const uint64_t head)
+{
+    return (struct lfstack_node *)(uintptr_t)(head & LFSTACK_POINTER_MASK);
+}
+
+static inline uint64_t internal_lfstack_unpack_tag(const uint64_t head)
+{
+    return ((head >> LFSTACK_POINTER_BITS) << LFSTACK_ALIGN_BITS) | (head & LFSTACK_ALIGN_MASK);
+}
+/// @endcond
+
+/**
+ * @brief Initialize an empty stack. Not thread-safe.
+ *
+ * @param[in] self              The stack pointer.
+ */
+static inline void lfstack_init(struct lfstack *self)
+{
+    assert(self);
+
+    atomic_init(&self->head, 0);
+}
+
+/**
+ * @brief Return whether the stack is empty. The result may be outdated by the
+ *        time it is returned, if other threads modify the stack.
+ *
+ * @param[in] self              The stack pointer.
+ *
+ * @return                      Whether the stack is empty.
+ */
+static inline bool lfstack_is_empty(struct lfstack *self)
+{
+    assert(self);
+
+    const uint64_t head = atomic_load_explicit(&self->head, memory_order_relaxed);
+
+    return internal_lfstack_unpack_node(head) == NULL;
+}
+
+/**
+ * @brief Push a node onto the stack.
+ *
+ * @param[in] self              The stack pointer.
+ * @param[in] node              The node pointer. Must not be in the stack already. Must fit in the tagged
+ *                              pointer, or abort() is called.
+ */
+static inline void lfstack_push(struct lfstack *self, struct lfstack_node *node)
+{
+    assert(self);
+    assert(node);
+
+    /* a pointer which doesn't fit would be silently corrupted, and dereferenced by pop */
+    if (((uint64_t)(uintptr_t)node & ~LFSTACK_POINTER_MASK) != 0) {
+        abort();
+    }
+
+    uint64_t head = atomic_load_explicit(&self->head, memory_order_relaxed);
+    uint64_t new_head;
+
+    do {
+        atomic_store_explicit(&node->next, internal_lfstack_unpack_node(head), memory_order_relaxed);
+
+        new_head = internal_lfstack_pack(node, internal_lfstack_unpack_tag(head) + 1);
+    } while (!atomic_compare_exchange_weak_explicit(&self->head, &head, new_head, memory_order_release,
+                                                    memory_order_relaxed));
+}
+
+/**
+ * @brief Pop the top node from the stack.
+ *
+ * @param[in] self              The stack pointer.
+ *
+ * @return                      The top node.
+ * @retval NULL                 If the stack is empty.
+ */
+static inline struct lfstack_node *lfstack_pop(struct lfstack *self)
+{
+    assert(self);
+
+    uint64_t head = atomic_load_explicit(&self->head, memory_order_acquire);
+
+    while (true) {
+        struct lfstack_node *node = internal_lfstack_unpack_node(head);
+
+        if (node == NULL) {
+            return NULL;
+        }
+
+        /* node may be popped by another thread in the meantime, in which case the tag has changed */
+        struct lfstack_node *next = atomic_load_explicit(&node->next, memory_order_relaxed);
+
+        const uint64_t new_head = internal_lfstack_pack(next, internal_lfstack_unpack_tag(head) + 1);
+
+        if (atomic_compare_exchange_weak_explicit(&self->head, &head, new_head, memory_order_acquire,
+                                                  memory_order_acquire)) {
+            return node;
+        }
+    }
+}
+
+/**
+ * @brief Pop all nodes from the stack at once.
+ *
+ * The nodes are linked from top to bottom, and can be traversed with
+ * `lfstack_node_next` by the calling thread only.
+ *
+ * @param[in] self              The stack pointer.
+ *
+ * @return                      The top node.
+ * @retval NULL                 If the stack is empty.
+ */
+static inline struct lfstack_node *lfstack_pop_all(struct lfstack *self)
+{
+    assert(self);
+
+    uint64_t head = atomic_load_explicit(&self->head, memory_order_relaxed);
+    uint64_t new_head;
+
+    do {
+        if (internal_lfstack_unpack_node(head) == NULL) {
+            return NULL;
+        }
+        new_head = internal_lfstack_pack(NULL, internal_lfstack_unpack_tag(head) + 1);
+    } while (!atomic_compare_exchange_weak_explicit(&self->head, &head, new_head, memory_order_acquire,
+                                                    memory_order_relaxed));
+
+    return internal_lfstack_unpack_node(head);
+}
+
+/**
+ * @brief Get the next node of a node, which has been popped with
+ *        `lfstack_pop_all`.
+ *
+ * @param[in] node              The node pointer.
+ *
+ * @return                      The next node.
+ * @retval NULL                 If the node is the last node.
+ */
+static inline struct lfstack_node *lfstack_node_next(const struct lfstack_node *node)
+{
+    assert(node);
+
+    return atomic_load_explicit(&node->next, memory_order_relaxed);
+}
+
+// vim: ft=c
@@ -23,6 +23,17 @@
 #include <stddef.h>
 #include <string.h>
 
+/**
+ * @def POOL_ZERO_MEMORY
+ * @brief Whether `pool_allocate` zeroes out the returned chunk. Defaults to 1.
+ *
+ * Define it as 0 to skip the `memset`. `pool_allocate_uninit` never zeroes
+ * the chunk.
+ */
+#ifndef POOL_ZERO_MEMORY
+#define POOL_ZERO_MEMORY 1
+#endif
+
 /**
  * @brief Pool node struct
  */
@@ -59,6 +70,8 @@ static inline void pool_deallocate_all(struct pool *self)
 
     const size_t chunk_count = self->buf_len / self->chunk_size;
 
+    self->head_ptr = NULL;
+
     for (size_t i = 0; i < chunk_count; i++) {
         unsigned char *ptr = &self->buf_ptr[i * self->chunk_size];
 
@@ -100,13 +113,14 @@ static inline void pool_init(struct pool *self, const size_t len, unsigned char
 }
 
 /**
- * @brief Get a pointer to a free block of previously given data size
+ * @brief Get a pointer to an uninitialized free block of previously given
+ *        data size
  *
  * @param[in] self              Pool pointer
  *
- * @returns                     A pointer to a zeroed-out memory chunk of data size.
+ * @returns                     A pointer to an uninitialized memory chunk of data size.
  */
-static inline void *pool_allocate(struct pool *self)
+static inline void *pool_allocate_uninit(struct pool *self)
 {
     struct pool_free_node *node = self->head_ptr;
 
@@ -116,11 +130,28 @@ static inline void *pool_allocate(struct pool *self)
 
     self->head_ptr = node->next_ptr;
 
-    memset(node, 0, self->chunk_size);
-
     return node;
 }
 
+/**
+ * @brief Get a pointer to a free block of previously given data size
+ *
+ * @param[in] self              Pool pointer
+ *
+ * @returns                     A pointer to a zeroed-out memory chunk of data size (uninitialized if
+ *                              `POOL_ZERO_MEMORY` is 0).
+ */
+static inline void *pool_allocate(struct pool *self)
+{
+    void *ptr = pool_allocate_uninit(self);
+
+    if (POOL_ZERO_MEMORY && ptr != NULL) {
+        memset(ptr, 0, self->chunk_size);
+    }
+
+    return ptr;
+}
+
 /**
  * @brief Free a memory chunk for further reuse.
  *
@@ -0,0 +1,362 @@
+/*  ringbuf.h
+ *
+ *  Copyright (C) 2023 abxh
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *  See the file LICENSE included with this distribution for more
+ *  information. */
+
+/**
+ * @file ringbuf.h
+ * @brief Byte-oriented ring buffer of variable-length records
+ *
+ * Records are stored contiguously in a (power-of-2 sized) byte buffer, each
+ * prefixed with a header containing the record length. A record is written by
+ * reserving space, writing into it, and committing it. A record is read by
+ * reading a pointer to the oldest record, and releasing it afterwards. No
+ * memory is allocated per record.
+ *
+ * Records never wrap around the end of the buffer. If a record does not fit
+ * before the end, the remaining bytes are skipped with a padding header. The
+ * skipped bytes count as used until the consumer has passed them, so records
+ * are limited to `ringbuf_max_len` bytes (half the capacity minus the header),
+ * such that a record always fits in an empty ring buffer.
+ *
+ * Define `RINGBUF_SPSC` before including this header to make the ring buffer
+ * safe for a single producer and a single consumer thread.
+ *
+ * Source used:
+ * @li https://fgiesen.wordpress.com/2010/12/14/ring-buffers-and-queues/
+ */
+
+#pragma once
+
+#include "align.h"   // calc_alignment_padding
+#include "is_pow2.h" // is_pow2
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @def RINGBUF_SPSC
+ * @brief Make the read and write indicies atomic, such that one producer thread
+ *        may reserve / commit while one consumer thread reads / releases.
+ */
+#ifdef RINGBUF_SPSC
+#include <stdatomic.h>
+#endif
+
+/**
+ * @def RINGBUF_ALIGNMENT
+ * @brief Alignment of records and their headers. The record data is aligned to
+ *        this as well.
+ */
+#define RINGBUF_ALIGNMENT (8U)
+
+/**
+ * @def RINGBUF_HEADER_SIZE
+ * @brief Size of the record header.
+ */
+#define RINGBUF_HEADER_SIZE RINGBUF_ALIGNMENT
+
+/**
+ * @def RINGBUF_PADDING_LEN
+ * @brief Record length used to flag padding to the end of the buffer.
+ */
+#define RINGBUF_PADDING_LEN (UINT32_MAX)
+
+/// @cond DO_NOT_DOCUMENT
+#ifdef RINGBUF_SPSC
+#define RINGBUF_INDEX_TYPE              alignas(64) _Atomic uint32_t
+#define RINGBUF_LOAD_ACQUIRE(index)     atomic_load_explicit(&(index), memory_order_acquire)
+#define RINGBUF_LOAD_RELAXED(index)     atomic_load_explicit(&(index), memory_order_relaxed)
+#define RINGBUF_STORE_RELEASE(index, x) atomic_store_explicit(&(index), (x), memory_order_release)
+#else
+#define RINGBUF_INDEX_TYPE              uint32_t
+#define RINGBUF_LOAD_ACQUIRE(index)     (index)
+#define RINGBUF_LOAD_RELAXED(index)     (index)
+#define RINGBUF_STORE_RELEASE(index, x) ((index) = (x))
+#endif
+/// @endcond
+
+/**
+ * @brief Ring buffer struct.
+ *
+ * The read and write indicies are counted upward without bound, and only
+ * masked when the buffer is accessed.
+ */
+struct ringbuf {
+    uint32_t capacity;              ///< Underlying buffer length. Power of 2.
+    uint32_t reserved_size;         ///< Size of the pending reservation (including header and padding).
+    uint32_t reserved_skip;         ///< Bytes skipped to the end of the buffer by the pending reservation.
+    unsigned char *buf_ptr;         ///< Underlying buffer pointer.
+    RINGBUF_INDEX_TYPE read_index;  ///< Index of the oldest record. Owned by the consumer.
+    RINGBUF_INDEX_TYPE write_index; ///< Index past the newest record. Owned by the producer.
+};
+
+/// @cond DO_NOT_DOCUMENT
+static inline uint32_t internal_ringbuf_record_size(const uint32_t len)
+{
+    return (uint32_t)(RINGBUF_HEADER_SIZE + len + calc_alignment_padding(RINGBUF_ALIGNMENT, len));
+}
+
+static inline void internal_ringbuf_write_header(unsigned char *ptr, const uint32_t len)
+{
+    memcpy(ptr, &len, sizeof(uint32_t));
+}
+
+static inline uint32_t internal_ringbuf_read_header(const unsigned char *ptr)
+{
+    uint32_t len;
+    memcpy(&len, ptr, sizeof(uint32_t));
+    return len;
+}
+/// @endcond
+
+/**
+ * @brief Initialize the ring buffer.
+ *
+ * The backing buffer is aligned to `RINGBUF_ALIGNMENT`, and the largest power
+ * of 2 that fits in the remaining length is used.
+ *
+ * @param[in] self              Ring buffer pointer.
+ * @param[in] len               Backing buffer length.
+ * @param[in] backing_buf       Backing buffer.
+ */
+static inline void ringbuf_init(struct ringbuf *self, const size_t len, unsigned char *backing_buf)
+{
+    assert(self);
+    assert(backing_buf);
+
+    const uintptr_t padding = calc_alignment_padding(RINGBUF_ALIGNMENT, (uintptr_t)backing_buf);
+
+    assert(len >= padding + 2 * RINGBUF_HEADER_SIZE);
+
+    size_t capacity = (size_t)1 << 31;
+    while (capacity > len - padding) {
+        capacity >>= 1;
+    }
+
+    self->buf_ptr = &backing_buf[padding];
+    self->capacity = (uint32_t)capacity;
+    self->reserved_size = 0;
+    self->reserved_skip = 0;
+    RINGBUF_STORE_RELEASE(self->read_index, 0);
+    RINGBUF_STORE_RELEASE(self->write_index, 0);
+}
+
+/**
+ * @brief Return whether the ring buffer has no committed records.
+ *
+ * @param[in] self              Ring buffer pointer.
+ *
+ * @return                      Whether the ring buffer is empty.
+ */
+static inline bool ringbuf_is_empty(struct ringbuf *self)
+{
+    assert(self);
+
+    return RINGBUF_LOAD_ACQUIRE(self->read_index) == RINGBUF_LOAD_ACQUIRE(self->write_index);
+}
+
+/**
+ * @brief Return the maximum record length of the ring buffer.
+ *
+ * A record of at most this length is accepted by an empty ring buffer,
+ * wherever the previous record ended.
+ *
+ * @param[in] self              Ring buffer pointer.
+ *
+ * @return                      Half the capacity minus the record header size.
+ */
+static inline uint32_t ringbuf_max_len(const struct ringbuf *self)
+{
+    assert(self);
+
+    return self->capacity / 2 - RINGBUF_HEADER_SIZE;
+}
+
+/**
+ * @brief Reserve space for a record of a given length. Called by the producer.
+ *
+ * At most one reservation may be pending at a time.
+ *
+ * @param[in] self              Ring buffer pointer.
+ * @param[in] len               Record length in bytes.
+ *
+ * @return                      A pointer to `len` contiguous bytes to write the record into.
+ * @retval NULL
+ *   @li                        If len is larger than `ringbuf_max_len`.
+ *   @li                        If there is not enough free space in the ring buffer.
+ */
+static inline void *ringbuf_reserve(struct ringbuf *self, const uint32_t len)
+{
+    assert(self);
+    assert(self->reserved_size == 0 && "reservation already pending!");
+
+    if (len > ringbuf_max_len(self)) {
+        return NULL;
+    }
+
+    const uint32_t size = internal_ringbuf_record_size(len);
+    const uint32_t write_index = RINGBUF_LOAD_RELAXED(self->write_index);
+    const uint32_t read_index = RINGBUF_LOAD_ACQUIRE(self->read_index);
+
+    const uint32_t free_size = self->capacity - (write_index - read_index);
+    const uint32_t offset = write_index & (self->capacity - 1);
+    const uint32_t size_till_end = self->capacity - offset;
+
+    uint32_t skip = 0;
+    if (size > size_till_end) {
+        skip = size_till_end;
+    }
+    if ((uint64_t)skip + size > free_size) {
+        return NULL;
+    }
+
+    if (skip > 0) {
+        internal_ringbuf_write_header(&self->buf_ptr[offset], RINGBUF_PADDING_LEN);
+    }
+
+    self->reserved_size = size;
+    self->reserved_skip = skip;
+
+    return &self->buf_ptr[((offset + skip) & (self->capacity - 1)) + RINGBUF_HEADER_SIZE];
+}
+
+/**
+ * @brief Commit the pending reservation, making the record visible to the
+ *        consumer. Called by the producer.
+ *
+ * @param[in] self              Ring buffer pointer.
+ * @param[in] len               Record length in bytes. May be smaller than the reserved length.
+ */
+static inline void ringbuf_commit(struct ringbuf *self, const uint32_t len)
+{
+    assert(self);
+    assert(self->reserved_size != 0 && "no reservation pending!");
+    assert(internal_ringbuf_record_size(len) <= self->reserved_size);
+
+    const uint32_t write_index = RINGBUF_LOAD_RELAXED(self->write_index);
+    const uint32_t offset = (write_index + self->reserved_skip) & (self->capacity - 1);
+
+    internal_ringbuf_write_header(&self->buf_ptr[offset], len);
+
+    RINGBUF_STORE_RELEASE(self->write_index, write_index + self->reserved_skip + internal_ringbuf_record_size(len));
+
+    self->reserved_size = 0;
+    self->reserved_skip = 0;
+}
+
+/**
+ * @brief Copy a record into the ring buffer. Called by the producer.
+ *
+ * @param[in] self              Ring buffer pointer.
+ * @param[in] data              Record data.
+ * @param[in] len               Record length in bytes.
+ *
+ * @return                      Whether the record was written.
+ * @retval false
+ *   @li                        If len is larger than `ringbuf_max_len`.
+ *   @li                        If there is not enough free space in the ring buffer.
+ */
+static inline bool ringbuf_push(struct ringbuf *self, const void *data, const uint32_t len)
+{
+    void *ptr = ringbuf_reserve(self, len);
+
+    if (!ptr) {
+        return false;
+    }
+
+    memcpy(ptr, data, len);
+
+    ringbuf_commit(self, len);
+
+    return true;
+}
+
+/**
+ * @brief Get the oldest record in the ring buffer. Called by the consumer.
+ *
+ * The record stays in the ring buffer until `ringbuf_release` is called.
+ *
+ * @param[in] self              Ring buffer pointer.
+ * @param[out] len_ptr          Pointer to store the record length in.
+ *
+ * @return                      A pointer to the record data.
+ * @retval NULL                 If the ring buffer is empty.
+ */
+static inline const void *ringbuf_read(struct ringbuf *self, uint32_t *len_ptr)
+{
+    assert(self);
+    assert(len_ptr);
+
+    uint32_t read_index = RINGBUF_LOAD_RELAXED(self->read_index);
+    const uint32_t write_index = RINGBUF_LOAD_ACQUIRE(self->write_index);
+
+    if (read_index == write_index) {
+        return NULL;
+    }
+
+    uint32_t offset = read_index & (self->capacity - 1);
+    uint32_t len = internal_ringbuf_read_header(&self->buf_ptr[offset]);
+
+    if (len == RINGBUF_PADDING_LEN) {
+        read_index += self->capacity - offset;
+        RINGBUF_STORE_RELEASE(self->read_index, read_index);
+
+        assert(read_index != write_index);
+
+        offset = 0;
+        len = internal_ringbuf_read_header(&self->buf_ptr[offset]);
+    }
+
+    *len_ptr = len;
+
+    return &self->buf_ptr[offset + RINGBUF_HEADER_SIZE];
+}
+
+/**
+ * @brief Release the oldest record, making its space available to the
+ *        producer. Called by the consumer after `ringbuf_read`.
+ *
+ * @param[in] self              Ring buffer pointer.
+ */
+static inline void ringbuf_release(struct ringbuf *self)
+{
+    assert(self);
+    assert(!ringbuf_is_empty(self));
+
+    const uint32_t read_index = RINGBUF_LOAD_RELAXED(self->read_index);
+    const uint32_t len = internal_ringbuf_read_header(&self->buf_ptr[read_index & (self->capacity - 1)]);
+
+    assert(len != RINGBUF_PADDING_LEN && "release called before read!");
+
+    RINGBUF_STORE_RELEASE(self->read_index, read_index + internal_ringbuf_record_size(len));
+}
+
+/**
+ * @brief Clear the records in the ring buffer.
+ *
+ * @warning Not safe to call while the producer or consumer is active.
+ *
+ * @param[in] self              Ring buffer pointer.
+ */
+static inline void ringbuf_clear(struct ringbuf *self)
+{
+    assert(self);
+
+    self->reserved_size = 0;
+    self->reserved_skip = 0;
+    RINGBUF_STORE_RELEASE(self->read_index, 0);
+    RINGBUF_STORE_RELEASE(self->write_index, 0);
+}
+
+// vim: ft=c
@@ -0,0 +1,169 @@
+/*  scratch_arena.h
+ *
+ *  Copyright (C) 2023 abxh
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *  See the file LICENSE included with this distribution for more
+ *  information. */
+
+/**
+ * @file scratch_arena.h
+ * @brief Thread-local scratch arenas
+ *
+ * Every thread has `SCRATCH_ARENA_COUNT` arenas for short-lived memory, which
+ * are created on first use and reused afterwards, so temporary allocations
+ * never call malloc() after warm-up. `scratch_begin` saves the state of one of
+ * them with `temp_arena_state_save`, and `scratch_end` restores it, freeing
+ * everything allocated in between:
+ *
+ * @code
+ * struct temp_arena_state scratch = scratch_begin(&out_arena, 1);
+ * int *tmp = arena_allocate(scratch.arena_ptr, n * sizeof(int));
+ * // ... compute into tmp, and allocate the result from out_arena ...
+ * scratch_end(scratch);
+ * @endcode
+ *
+ * A function that takes an arena for its result, and allocates from a scratch
+ * arena itself, must pass the result arena as a conflict. Otherwise, it may
+ * get the same arena back, if the caller's arena is a scratch arena itself,
+ * and `scratch_end` would free the result. Having two arenas per thread is
+ * enough, as long as a function has at most one such arena parameter.
+ *
+ * The arenas are backed by `SCRATCH_ARENA_RESERVE_LEN` bytes of reserved
+ * virtual memory each, or by a buffer of that size from malloc() where this
+ * is not supported. The scratch arenas are static, so each translation unit
+ * including this header has its own set per thread.
+ */
+
+#pragma once
+
+#include "arena.h" // arena, arena_init, arena_init_virtual, temp_arena_state
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+/**
+ * @def SCRATCH_ARENA_COUNT
+ * @brief Number of scratch arenas per thread. Defaults to 2.
+ */
+#ifndef SCRATCH_ARENA_COUNT
+#define SCRATCH_ARENA_COUNT 2
+#endif
+
+/**
+ * @def SCRATCH_ARENA_RESERVE_LEN
+ * @brief Length of each scratch arena. Defaults to 64 MiB.
+ */
+#ifndef SCRATCH_ARENA_RESERVE_LEN
+#define SCRATCH_ARENA_RESERVE_LEN ((size_t)64 * 1024 * 1024)
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#ifdef __cplusplus
+#define SCRATCH_ARENA_THREAD_LOCAL thread_local
+#else
+#define SCRATCH_ARENA_THREAD_LOCAL _Thread_local
+#endif
+
+static SCRATCH_ARENA_THREAD_LOCAL struct arena internal_scratch_arenas[SCRATCH_ARENA_COUNT];
+
+static inline bool internal_scratch_arena_init(struct arena *arena_ptr)
+{
+    if (arena_init_virtual(arena_ptr, SCRATCH_ARENA_RESERVE_LEN)) {
+        return true;
+    }
+
+    unsigned char *buf = (unsigned char *)malloc(SCRATCH_ARENA_RESERVE_LEN);
+
+    if (!buf) {
+        return false;
+    }
+
+    arena_init(arena_ptr, SCRATCH_ARENA_RESERVE_LEN, buf);
+
+    return true;
+}
+/// @endcond
+
+/**
+ * @brief Begin a scratch region in one of the calling thread's scratch
+ *        arenas, which is not one of the given conflicting arenas.
+ *
+ * @param[in] conflicts         Arenas which are in use by the caller. May be NULL if conflict_count is 0.
+ * @param[in] conflict_count    Number of conflicting arenas. Must be less than `SCRATCH_ARENA_COUNT`.
+ *
+ * @return                      The saved state of the scratch arena. Allocate from its `arena_ptr`.
+ * @retval arena_ptr == NULL    If the scratch arena couldn't be created on first use.
+ */
+static inline struct temp_arena_state scratch_begin(struct arena *const *conflicts, const size_t conflict_count)
+{
+    assert(conflict_count < SCRATCH_ARENA_COUNT);
+    assert(conflicts != NULL || conflict_count == 0);
+
+    struct arena *arena_ptr = NULL;
+
+    for (size_t i = 0; i < SCRATCH_ARENA_COUNT && arena_ptr == NULL; i++) {
+        arena_ptr = &internal_scratch_arenas[i];
+
+        for (size_t j = 0; j < conflict_count; j++) {
+            if (conflicts[j] == arena_ptr) {
+                arena_ptr = NULL;
+                break;
+            }
+        }
+    }
+    assert(arena_ptr != NULL);
+
+    if (arena_ptr->buf_ptr == NULL && !internal_scratch_arena_init(arena_ptr)) {
+        struct temp_arena_state failed_state = {NULL, 0, 0};
+        return failed_state;
+    }
+
+    return temp_arena_state_save(arena_ptr);
+}
+
+/**
+ * @brief End a scratch region, freeing everything allocated in the scratch
+ *        arena since the matching `scratch_begin`.
+ *
+ * @param[in] scratch           The state returned by `scratch_begin`.
+ */
+static inline void scratch_end(const struct temp_arena_state scratch)
+{
+    if (scratch.arena_ptr == NULL) {
+        return;
+    }
+
+    temp_arena_state_restore(scratch);
+}
+
+/**
+ * @brief Release the calling thread's scratch arenas. They are created again
+ *        on the next `scratch_begin`. Call it before a thread exits.
+ */
+static inline void scratch_arena_release_thread(void)
+{
+    for (size_t i = 0; i < SCRATCH_ARENA_COUNT; i++) {
+        struct arena *arena_ptr = &internal_scratch_arenas[i];
+
+        if (arena_ptr->buf_ptr == NULL) {
+            continue;
+        }
+
+        if (arena_ptr->reserve_len > 0) {
+            arena_deinit_virtual(arena_ptr);
+        }
+        else {
+            /* malloc() returns memory aligned to max_align_t, so arena_init didn't offset the buffer */
+            free(arena_ptr->buf_ptr);
+            arena_ptr->buf_ptr = NULL;
+        }
+    }
+}
+
+// vim: ft=c
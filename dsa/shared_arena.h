@@ -0,0 +1,288 @@
+/*  shared_arena.h
+ *
+ *  Copyright (C) 2023 abxh
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *  See the file LICENSE included with this distribution for more
+ *  information. */
+
+/**
+ * @file shared_arena.h
+ * @brief Thread-safe arena allocator
+ *
+ * An arena which can be allocated from by multiple threads at once. An
+ * allocation is a single atomic `fetch_add` on the offset. To make this
+ * possible, every request is rounded up to a multiple of
+ * `alignof(max_align_t)`, such that the offset is always aligned to it, and
+ * requests with a larger alignment are padded, such that the pointer can be
+ * aligned within the chunk afterwards. Chunks can thus not be reallocated or
+ * freed individually.
+ *
+ * Threads allocating often should carve a local `struct arena` out of the
+ * shared arena with `shared_arena_init_local`, and allocate from it with
+ * `shared_arena_local_allocate`, which only touches the shared offset when
+ * the local arena is full.
+ */
+
+#pragma once
+
+#include "align.h"   // align, calc_alignment_padding
+#include "arena.h"   // arena, arena_init, arena_allocate_aligned, ARENA_ZERO_MEMORY
+#include "is_pow2.h" // is_pow2
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @def SHARED_ARENA_LOCAL_LEN
+ * @brief Number of bytes carved out of the shared arena at a time for a local
+ *        arena. Defaults to 64 KiB.
+ */
+#ifndef SHARED_ARENA_LOCAL_LEN
+#define SHARED_ARENA_LOCAL_LEN ((size_t)64 * 1024)
+#endif
+
+/**
+ * @brief Shared arena data struct.
+ */
+struct shared_arena {
+    _Atomic size_t curr_offset; ///< Current offset relative to buf_ptr. May exceed buf_len when full.
+    size_t buf_len;             ///< Underlying buffer length.
+    unsigned char *buf_ptr;     ///< Underlying buffer pointer.
+};
+
+/**
+ * @brief Initialize the shared arena. Not thread-safe.
+ *
+ * @param[in] self              Shared arena pointer.
+ * @param[in] len               Backing buffer length.
+ * @param[in] backing_buf       Backing buffer.
+ */
+static inline void shared_arena_init(struct shared_arena *self, const size_t len, unsigned char *backing_buf)
+{
+    assert(self);
+    assert(backing_buf);
+
+    const uintptr_t padding = calc_alignment_padding(alignof(max_align_t), (uintptr_t)backing_buf);
+
+    assert(len >= padding);
+
+    self->buf_ptr = &backing_buf[padding];
+    self->buf_len = len - padding;
+    atomic_init(&self->curr_offset, 0);
+}
+
+/**
+ * @brief Deallocate all allocations in the shared arena. Not thread-safe.
+ *
+ * @param[in] self              Shared arena pointer.
+ */
+static inline void shared_arena_deallocate_all(struct shared_arena *self)
+{
+    assert(self);
+
+    atomic_store_explicit(&self->curr_offset, 0, memory_order_relaxed);
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline void *internal_shared_arena_allocate_aligned(struct shared_arena *self, const size_t alignment,
+                                                           const size_t size, const bool zero)
+{
+    assert(self);
+    assert(is_pow2(alignment));
+
+    const size_t extra = alignment > alignof(max_align_t) ? alignment - alignof(max_align_t) : 0;
+
+    if (size > self->buf_len || extra > self->buf_len - size) {
+        return NULL;
+    }
+
+    /* keep the offset aligned to max_align_t by rounding the request */
+    const size_t request = size + extra + calc_alignment_padding(alignof(max_align_t), size + extra);
+
+    if (request > self->buf_len) {
+        return NULL;
+    }
+
+    /* don't keep bumping the offset of a full arena */
+    if (atomic_load_explicit(&self->curr_offset, memory_order_relaxed) > self->buf_len - request) {
+        return NULL;
+    }
+
+    const size_t offset = atomic_fetch_add_explicit(&self->curr_offset, request, memory_order_relaxed);
+
+    if (offset > self->buf_len - request) {
+        return NULL;
+    }
+
+    void *ptr = &self->buf_ptr[offset];
+    size_t space_left = request;
+
+    const bool has_space_left = align(alignment, size, &ptr, &space_left);
+    assert(has_space_left);
+    (void)(has_space_left);
+
+    if (zero) {
+        memset(ptr, 0, size);
+    }
+
+    return ptr;
+}
+/// @endcond
+
+/**
+ * @brief Get the pointer to a chunk of the shared arena. With specific
+ *        alignment. Thread-safe.
+ *
+ * @param[in] self              Shared arena pointer.
+ * @param[in] alignment         Alignment size.
+ * @param[in] size              Chunk size.
+ *
+ * @return                      A pointer to a zeroed-out memory chunk (uninitialized if `ARENA_ZERO_MEMORY` is 0).
+ * @retval NULL                 If the shared arena doesn't have enough memory for the allocation.
+ */
+static inline void *shared_arena_allocate_aligned(struct shared_arena *self, const size_t alignment,
+                                                  const size_t size)
+{
+    return internal_shared_arena_allocate_aligned(self, alignment, size, ARENA_ZERO_MEMORY);
+}
+
+/**
+ * @brief Get the pointer to an uninitialized chunk of the shared arena. With
+ *        specific alignment. Thread-safe.
+ *
+ * @param[in] self              Shared arena pointer.
+ * @param[in] alignment         Alignment size.
+ * @param[in] size              Chunk size.
+ *
+ * @return                      A pointer to an uninitialized memory chunk.
+ * @retval NULL                 If the shared arena doesn't have enough memory for the allocation.
+ */
+static inline void *shared_arena_allocate_aligned_uninit(struct shared_arena *self, const size_t alignment,
+                                                         const size_t size)
+{
+    return internal_shared_arena_allocate_aligned(self, alignment, size, false);
+}
+
+/**
+ * @brief Get the pointer to a chunk of the shared arena. Thread-safe.
+ *
+ * @param[in] self              Shared arena pointer.
+ * @param[in] size              Chunk size.
+ *
+ * @return                      A pointer to a zeroed-out memory chunk (uninitialized if `ARENA_ZERO_MEMORY` is 0).
+ * @retval NULL                 If the shared arena doesn't have enough memory for the allocation.
+ */
+static inline void *shared_arena_allocate(struct shared_arena *self, const size_t size)
+{
+    return shared_arena_allocate_aligned(self, alignof(max_align_t), size);
+}
+
+/**
+ * @brief Get the pointer to an uninitialized chunk of the shared arena.
+ *        Thread-safe.
+ *
+ * @param[in] self              Shared arena pointer.
+ * @param[in] size              Chunk size.
+ *
+ * @return                      A pointer to an uninitialized memory chunk.
+ * @retval NULL                 If the shared arena doesn't have enough memory for the allocation.
+ */
+static inline void *shared_arena_allocate_uninit(struct shared_arena *self, const size_t size)
+{
+    return shared_arena_allocate_aligned_uninit(self, alignof(max_align_t), size);
+}
+
+/**
+ * @brief Initialize a thread-local arena with a chunk carved out of the
+ *        shared arena. Thread-safe.
+ *
+ * The local arena is an ordinary `struct arena` which is only to be used by
+ * one thread. Its memory is owned by the shared arena.
+ *
+ * @param[in] self              Shared arena pointer.
+ * @param[out] local_ptr        Local arena pointer.
+ * @param[in] len               Length of the chunk to carve out.
+ *
+ * @return                      Whether the chunk could be carved out. The local arena is unchanged otherwise.
+ */
+static inline bool shared_arena_init_local(struct shared_arena *self, struct arena *local_ptr, const size_t len)
+{
+    assert(local_ptr);
+
+    unsigned char *chunk = (unsigned char *)shared_arena_allocate_uninit(self, len);
+
+    if (!chunk) {
+        return false;
+    }
+
+    arena_init(local_ptr, len, chunk);
+
+    return true;
+}
+
+/**
+ * @brief Get the pointer to a chunk of a local arena. With specific alignment.
+ *        A new chunk of `SHARED_ARENA_LOCAL_LEN` bytes (or more, for large
+ *        allocations) is carved out of the shared arena, if the local arena is
+ *        full. The rest of the old chunk is left unused.
+ *
+ * @param[in] self              Shared arena pointer.
+ * @param[in,out] local_ptr     Local arena pointer. Zero-initialize it before the first call.
+ * @param[in] alignment         Alignment size.
+ * @param[in] size              Chunk size.
+ *
+ * @return                      A pointer to a zeroed-out memory chunk (uninitialized if `ARENA_ZERO_MEMORY` is 0).
+ * @retval NULL                 If the shared arena doesn't have enough memory for the allocation.
+ */
+static inline void *shared_arena_local_allocate_aligned(struct shared_arena *self, struct arena *local_ptr,
+                                                        const size_t alignment, const size_t size)
+{
+    assert(self);
+    assert(local_ptr);
+
+    void *ptr = local_ptr->buf_ptr ? arena_allocate_aligned(local_ptr, alignment, size) : NULL;
+
+    if (ptr) {
+        return ptr;
+    }
+
+    if (size > SIZE_MAX - alignment - SHARED_ARENA_LOCAL_LEN) {
+        return NULL;
+    }
+
+    const size_t min_len = size + alignment;
+    const size_t len = min_len > SHARED_ARENA_LOCAL_LEN ? min_len : SHARED_ARENA_LOCAL_LEN;
+
+    if (!shared_arena_init_local(self, local_ptr, len)) {
+        return NULL;
+    }
+
+    return arena_allocate_aligned(local_ptr, alignment, size);
+}
+
+/**
+ * @brief Get the pointer to a chunk of a local arena. See
+ *        `shared_arena_local_allocate_aligned`.
+ *
+ * @param[in] self              Shared arena pointer.
+ * @param[in,out] local_ptr     Local arena pointer. Zero-initialize it before the first call.
+ * @param[in] size              Chunk size.
+ *
+ * @return                      A pointer to a zeroed-out memory chunk (uninitialized if `ARENA_ZERO_MEMORY` is 0).
+ * @retval NULL                 If the shared arena doesn't have enough memory for the allocation.
+ */
+static inline void *shared_arena_local_allocate(struct shared_arena *self, struct arena *local_ptr, const size_t size)
+{
+    return shared_arena_local_allocate_aligned(self, local_ptr, alignof(max_align_t), size);
+}
+
+// vim: ft=c
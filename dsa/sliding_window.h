@@ -0,0 +1,354 @@
+/*  sliding_window.h
+ *
+ *  Copyright (C) 2023 abxh
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *  See the file LICENSE included with this distribution for more
+ *  information. */
+
+/**
+ * @file sliding_window.h
+ * @brief Sliding window aggregates (sum, mean, variance, min, max)
+ *
+ * The window values are kept in a `fqueue`. Every aggregate is updated in
+ * amortized O(1) time per pushed / evicted value:
+ *  @li The sum is compensated (Kahan-Babuska-Neumaier), such that the rounding
+ *      error does not accumulate as values are pushed and evicted.
+ *  @li The variance is maintained with Welford's algorithm, extended to
+ *      removals.
+ *  @li The min and max are the front of monotonic deques.
+ *
+ * Sources used:
+ * @li https://en.wikipedia.org/wiki/Kahan_summation_algorithm#Further_enhancements
+ * @li https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Welford's_online_algorithm
+ * @li https://leetcode.com/problems/sliding-window-maximum/
+ */
+
+/**
+ * @example examples/fqueue/moving_average_from_data_stream.c
+ * Examples of how `sliding_window.h` header file is used in practice.
+ */
+
+#pragma once
+
+#include <assert.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/// @cond DO_NOT_DOCUMENT
+#define NAME       sliding_window_queue
+#define VALUE_TYPE double
+/// @endcond
+#include "fqueue.h"
+
+/// @cond DO_NOT_DOCUMENT
+#define NAME       sliding_window_deque
+#define VALUE_TYPE double
+/// @endcond
+#include "deque.h"
+
+/**
+ * @brief Sliding window struct.
+ */
+struct sliding_window {
+    uint32_t window_size;                    ///< Maximum number of values in the window.
+    double sum;                              ///< Sum of the values in the window.
+    double sum_compensation;                 ///< Running compensation for the lost low-order bits of `sum`.
+    double mean;                             ///< Welford running mean.
+    double m2;                               ///< Welford running sum of squared differences from the mean.
+    struct sliding_window_queue *values;     ///< Values in the window from oldest to newest.
+    struct sliding_window_deque *min_values; ///< Non-decreasing candidates for the min value.
+    struct sliding_window_deque *max_values; ///< Non-increasing candidates for the max value.
+};
+
+/// @cond DO_NOT_DOCUMENT
+static inline void internal_sliding_window_add_to_sum(struct sliding_window *self, const double value)
+{
+    const double t = self->sum + value;
+
+    if (fabs(self->sum) >= fabs(value)) {
+        self->sum_compensation += (self->sum - t) + value;
+    }
+    else {
+        self->sum_compensation += (value - t) + self->sum;
+    }
+    self->sum = t;
+}
+/// @endcond
+
+/**
+ * @brief Create a sliding window with a given size with malloc().
+ *
+ * @param[in] window_size       Maximum number of values in the window.
+ *
+ * @return                      A pointer to the sliding window.
+ * @retval NULL
+ *   @li                        If malloc fails.
+ *   @li                        If window size is 0 or larger than UINT32_MAX / 2 + 1.
+ */
+static inline struct sliding_window *sliding_window_create(const uint32_t window_size)
+{
+    if (window_size == 0 || window_size > UINT32_MAX / 2 + 1) {
+        return NULL;
+    }
+
+    struct sliding_window *self = (struct sliding_window *)calloc(1, sizeof(struct sliding_window));
+
+    if (!self) {
+        return NULL;
+    }
+
+    self->values = sliding_window_queue_create(window_size);
+    self->min_values = sliding_window_deque_create(window_size);
+    self->max_values = sliding_window_deque_create(window_size);
+
+    if (!self->values || !self->min_values || !self->max_values) {
+        if (self->values) {
+            sliding_window_queue_destroy(self->values);
+        }
+        if (self->min_values) {
+            sliding_window_deque_destroy(self->min_values);
+        }
+        if (self->max_values) {
+            sliding_window_deque_destroy(self->max_values);
+        }
+        free(self);
+        return NULL;
+    }
+
+    self->window_size = window_size;
+
+    return self;
+}
+
+/**
+ * @brief Destroy a sliding window and free the underlying memory with free().
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The sliding window pointer.
+ */
+static inline void sliding_window_destroy(struct sliding_window *self)
+{
+    assert(self);
+
+    sliding_window_queue_destroy(self->values);
+    sliding_window_deque_destroy(self->min_values);
+    sliding_window_deque_destroy(self->max_values);
+    free(self);
+}
+
+/**
+ * @brief Return the number of values in the window.
+ *
+ * @param[in] self              The sliding window pointer.
+ *
+ * @return                      The number of values.
+ */
+static inline uint32_t sliding_window_count(const struct sliding_window *self)
+{
+    assert(self);
+
+    return self->values->count;
+}
+
+/**
+ * @brief Return whether the window is empty.
+ *
+ * @param[in] self              The sliding window pointer.
+ *
+ * @return                      Whether the window is empty.
+ */
+static inline bool sliding_window_is_empty(const struct sliding_window *self)
+{
+    assert(self);
+
+    return self->values->count == 0;
+}
+
+/**
+ * @brief Return whether the window is full, i.e. whether the next push evicts
+ *        the oldest value.
+ *
+ * @param[in] self              The sliding window pointer.
+ *
+ * @return                      Whether the window is full.
+ */
+static inline bool sliding_window_is_full(const struct sliding_window *self)
+{
+    assert(self);
+
+    return self->values->count == self->window_size;
+}
+
+/**
+ * @brief Evict the oldest value from a non-empty window.
+ *
+ * @param[in] self              The sliding window pointer.
+ *
+ * @return                      The evicted value.
+ */
+static inline double sliding_window_pop(struct sliding_window *self)
+{
+    assert(self);
+    assert(!sliding_window_is_empty(self));
+
+    const double value = sliding_window_queue_dequeue(self->values);
+
+    internal_sliding_window_add_to_sum(self, -value);
+
+    const uint32_t n = self->values->count;
+    if (n == 0) {
+        self->sum = self->sum_compensation = 0.;
+        self->mean = self->m2 = 0.;
+    }
+    else {
+        const double delta = value - self->mean;
+        self->mean -= delta / (double)n;
+        self->m2 -= delta * (value - self->mean);
+        self->m2 = self->m2 < 0. ? 0. : self->m2;
+    }
+
+    if (sliding_window_deque_get_front(self->min_values) == value) {
+        sliding_window_deque_pop_front(self->min_values);
+    }
+    if (sliding_window_deque_get_front(self->max_values) == value) {
+        sliding_window_deque_pop_front(self->max_values);
+    }
+
+    return value;
+}
+
+/**
+ * @brief Push a value into the window. The oldest value is evicted if the
+ *        window is full.
+ *
+ * @param[in] self              The sliding window pointer.
+ * @param[in] value             The value.
+ */
+static inline void sliding_window_push(struct sliding_window *self, const double value)
+{
+    assert(self);
+
+    if (sliding_window_is_full(self)) {
+        sliding_window_pop(self);
+    }
+
+    sliding_window_queue_enqueue(self->values, value);
+
+    internal_sliding_window_add_to_sum(self, value);
+
+    const double delta = value - self->mean;
+    self->mean += delta / (double)self->values->count;
+    self->m2 += delta * (value - self->mean);
+
+    while (!sliding_window_deque_is_empty(self->min_values)
+           && sliding_window_deque_get_back(self->min_values) > value) {
+        sliding_window_deque_pop_back(self->min_values);
+    }
+    sliding_window_deque_push_back(self->min_values, value);
+
+    while (!sliding_window_deque_is_empty(self->max_values)
+           && sliding_window_deque_get_back(self->max_values) < value) {
+        sliding_window_deque_pop_back(self->max_values);
+    }
+    sliding_window_deque_push_back(self->max_values, value);
+}
+
+/**
+ * @brief Clear the values in the window.
+ *
+ * @param[in] self              The sliding window pointer.
+ */
+static inline void sliding_window_clear(struct sliding_window *self)
+{
+    assert(self);
+
+    sliding_window_queue_clear(self->values);
+    sliding_window_deque_clear(self->min_values);
+    sliding_window_deque_clear(self->max_values);
+
+    self->sum = self->sum_compensation = 0.;
+    self->mean = self->m2 = 0.;
+}
+
+/**
+ * @brief Get the sum of the values in the window.
+ *
+ * @param[in] self              The sliding window pointer.
+ *
+ * @return                      The compensated sum. `0` if the window is empty.
+ */
+static inline double sliding_window_sum(const struct sliding_window *self)
+{
+    assert(self);
+
+    return self->sum + self->sum_compensation;
+}
+
+/**
+ * @brief Get the mean of the values in a non-empty window.
+ *
+ * @param[in] self              The sliding window pointer.
+ *
+ * @return                      The mean.
+ */
+static inline double sliding_window_mean(const struct sliding_window *self)
+{
+    assert(self);
+    assert(!sliding_window_is_empty(self));
+
+    return sliding_window_sum(self) / (double)self->values->count;
+}
+
+/**
+ * @brief Get the (population) variance of the values in a non-empty window.
+ *
+ * @param[in] self              The sliding window pointer.
+ *
+ * @return                      The variance.
+ */
+static inline double sliding_window_variance(const struct sliding_window *self)
+{
+    assert(self);
+    assert(!sliding_window_is_empty(self));
+
+    return self->m2 / (double)self->values->count;
+}
+
+/**
+ * @brief Get the min value in a non-empty window.
+ *
+ * @param[in] self              The sliding window pointer.
+ *
+ * @return                      The min value.
+ */
+static inline double sliding_window_min(const struct sliding_window *self)
+{
+    assert(self);
+    assert(!sliding_window_is_empty(self));
+
+    return sliding_window_deque_get_front(self->min_values);
+}
+
+/**
+ * @brief Get the max value in a non-empty window.
+ *
+ * @param[in] self              The sliding window pointer.
+ *
+ * @return                      The max value.
+ */
+static inline double sliding_window_max(const struct sliding_window *self)
+{
+    assert(self);
+    assert(!sliding_window_is_empty(self));
+
+    return sliding_window_deque_get_front(self->max_values);
+}
+
+// vim: ft=c
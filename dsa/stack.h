@@ -0,0 +1,452 @@
+/*  stack.h
+ *
+ *  Copyright (C) 2023 abxh
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *  See the file LICENSE included with this distribution for more
+ *  information. */
+
+/**
+ * @file stack.h
+ * @brief Growable array-based stack
+ *
+ * Same as `fstack.h`, but the values are kept in a separate buffer, which is
+ * doubled in size when the stack is full. The buffer is allocated with
+ * malloc() / realloc(), or from an arena if the stack is created with one.
+ *
+ * The stack struct has the same `count` and `values` members as `fstack.h`,
+ * such that `fstack_for_each` / `fstack_for_each_reverse` work as well.
+ *
+ * The following macros must be defined:
+ *      @li `NAME`
+ *      @li `VALUE_TYPE`
+ */
+
+// macro definitions: {{{
+
+#ifndef STACK_H
+#define STACK_H
+
+#include "arena.h" // arena, arena_allocate, arena_reallocate
+#include "paste.h" // PASTE, XPASTE, JOIN
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @def stack_for_each(self, index, value)
+ * @brief Iterate over the values in the stack from the top to bottom.
+ *
+ * @warning Modifying the stack under the iteration may result in errors.
+ *
+ * @param[in] self              Stack pointer.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t`.
+ * @param[out] value            Current value. Should be `VALUE_TYPE`.
+ */
+#define stack_for_each(self, index, value) \
+    for ((index) = (self)->count; (index) > 0 && ((value) = (self)->values[(index) - 1], true); (index)--)
+
+/**
+ * @def stack_for_each_reverse(self, index, value)
+ * @brief Iterate over the values in the stack from the bottom to top.
+ *
+ * @warning Modifying the stack under the iteration may result in errors.
+ *
+ * @param[in] self              Stack pointer.
+ * @param[in] index             Temporary indexing variable. Should be `uint32_t`.
+ * @param[out] value            Current value. Should be `VALUE_TYPE`.
+ */
+#define stack_for_each_reverse(self, index, value) \
+    for ((index) = 0; (index) < (self)->count && ((value) = (self)->values[(index)], true); (index)++)
+
+#endif // STACK_H
+
+/**
+ * @def NAME
+ * @brief Prefix to stack type and operations. This must be manually defined
+ *        before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef NAME
+#define NAME stack
+#error "Must define NAME."
+#else
+#define STACK_NAME NAME
+#endif
+
+/**
+ * @def VALUE_TYPE
+ * @brief Stack value type. This must be manually defined before including this
+ *        header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef VALUE_TYPE
+#define VALUE_TYPE int
+#error "Must define VALUE_TYPE."
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#define STACK_TYPE     struct STACK_NAME
+#define STACK_IS_EMPTY JOIN(STACK_NAME, is_empty)
+#define STACK_IS_FULL  JOIN(STACK_NAME, is_full)
+#define STACK_RESERVE  JOIN(STACK_NAME, reserve)
+#define STACK_GROW     JOIN(internal, JOIN(STACK_NAME, grow))
+/// @endcond
+
+// }}}
+
+// type definitions: {{{
+
+/**
+ * @brief Generated stack struct type for a given `VALUE_TYPE`.
+ */
+struct STACK_NAME {
+    uint32_t count;          ///< Number of values.
+    uint32_t capacity;       ///< Number of values allocated for.
+    VALUE_TYPE *values;      ///< Pointer to array of values.
+    struct arena *arena_ptr; ///< Arena the values are allocated from. NULL if malloc() is used.
+};
+
+// }}}
+
+// function definitions: {{{
+
+/**
+ * @brief Create a stack struct with a given initial capacity with malloc().
+ *
+ * @param[in] min_capacity      Number of elements expected to be stored initially.
+ *
+ * @return                      A pointer to the stack.
+ * @retval NULL
+ *   @li                        If malloc fails.
+ *   @li                        If capacity is 0.
+ */
+static inline STACK_TYPE *JOIN(STACK_NAME, create)(const uint32_t min_capacity)
+{
+    if (min_capacity == 0) {
+        return NULL;
+    }
+
+    STACK_TYPE *self = (STACK_TYPE *)calloc(1, sizeof(STACK_TYPE));
+
+    if (!self) {
+        return NULL;
+    }
+
+    self->values = (VALUE_TYPE *)malloc((size_t)min_capacity * sizeof(VALUE_TYPE));
+
+    if (!self->values) {
+        free(self);
+        return NULL;
+    }
+
+    self->count = 0;
+    self->capacity = min_capacity;
+    self->arena_ptr = NULL;
+
+    return self;
+}
+
+/**
+ * @brief Create a stack struct with a given initial capacity in an arena.
+ *
+ * The stack struct and the values are allocated from the arena, and the values
+ * are grown with `arena_reallocate_uninit`, which grows them in place if they are the
+ * last allocation in the arena. The memory is owned by the arena.
+ *
+ * @param[in] arena_ptr         The arena pointer.
+ * @param[in] min_capacity      Number of elements expected to be stored initially.
+ *
+ * @return                      A pointer to the stack.
+ * @retval NULL
+ *   @li                        If the arena doesn't have enough memory.
+ *   @li                        If capacity is 0.
+ */
+static inline STACK_TYPE *JOIN(STACK_NAME, create_with_arena)(struct arena *arena_ptr, const uint32_t min_capacity)
+{
+    assert(arena_ptr != NULL);
+
+    if (min_capacity == 0) {
+        return NULL;
+    }
+
+    STACK_TYPE *self = (STACK_TYPE *)arena_allocate(arena_ptr, sizeof(STACK_TYPE));
+
+    if (!self) {
+        return NULL;
+    }
+
+    self->values = (VALUE_TYPE *)arena_allocate_uninit(arena_ptr, (size_t)min_capacity * sizeof(VALUE_TYPE));
+
+    if (!self->values) {
+        return NULL;
+    }
+
+    self->count = 0;
+    self->capacity = min_capacity;
+    self->arena_ptr = arena_ptr;
+
+    return self;
+}
+
+/**
+ * @brief Destroy a stack struct and free the underlying memory with free().
+ *        Does nothing if the stack was created with an arena.
+ *
+ * @warning May not be called twice in a row on the same object.
+ *
+ * @param[in] self              The stack pointer.
+ */
+static inline void JOIN(STACK_NAME, destroy)(STACK_TYPE *self)
+{
+    assert(self != NULL);
+
+    if (self->arena_ptr) {
+        return;
+    }
+
+    free(self->values);
+    free(self);
+}
+
+/**
+ * @brief Return whether the stack is empty.
+ *
+ * @param[in] self              The stack pointer.
+ *
+ * @return                      Whether the stack is empty.
+ */
+static inline bool JOIN(STACK_NAME, is_empty)(const STACK_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == 0;
+}
+
+/**
+ * @brief Return whether the stack is full, i.e. whether the next push will
+ *        grow the underlying buffer.
+ *
+ * @param[in] self              The stack pointer.
+ *
+ * @return                      Whether the stack is full.
+ */
+static inline bool JOIN(STACK_NAME, is_full)(const STACK_TYPE *self)
+{
+    assert(self != NULL);
+
+    return self->count == self->capacity;
+}
+
+/**
+ * @brief Grow the stack, such that it can hold at least a given number of
+ *        values without reallocating.
+ *
+ * @param[in] self              The stack pointer.
+ * @param[in] min_capacity      Minimum capacity.
+ *
+ * @return                      Whether the stack can hold `min_capacity` values.
+ * @retval false                If realloc fails or the arena doesn't have enough memory.
+ */
+static inline bool JOIN(STACK_NAME, reserve)(STACK_TYPE *self, const uint32_t min_capacity)
+{
+    assert(self != NULL);
+
+    if (min_capacity <= self->capacity) {
+        return true;
+    }
+
+    const size_t old_size = (size_t)self->capacity * sizeof(VALUE_TYPE);
+    const size_t new_size = (size_t)min_capacity * sizeof(VALUE_TYPE);
+
+    VALUE_TYPE *values;
+    if (self->arena_ptr) {
+        values = (VALUE_TYPE *)arena_reallocate_uninit(self->arena_ptr, self->values, old_size, new_size);
+    }
+    else {
+        values = (VALUE_TYPE *)realloc(self->values, new_size);
+    }
+
+    if (!values) {
+        return false;
+    }
+
+    self->values = values;
+    self->capacity = min_capacity;
+
+    return true;
+}
+
+/// @cond DO_NOT_DOCUMENT
+static inline bool JOIN(internal, JOIN(STACK_NAME, grow))(STACK_TYPE *self)
+{
+    if (self->capacity == UINT32_MAX) {
+        return false;
+    }
+    return STACK_RESERVE(self, self->capacity > UINT32_MAX / 2 ? UINT32_MAX : 2 * self->capacity);
+}
+/// @endcond
+
+/**
+ * @brief Get the value at index.
+ *
+ * @note Index starts from the top as `0` and is counted upward to `count - 1`
+ *       as bottom.
+ *
+ * @param[in] self              The stack pointer.
+ * @param[in] index             The index to retrieve to value from.
+ *
+ * @return                      The value at `index`.
+ */
+static inline VALUE_TYPE JOIN(STACK_NAME, at)(const STACK_TYPE *self, const uint32_t index)
+{
+    assert(self != NULL);
+    assert(index < self->count);
+
+    return self->values[self->count - 1 - index];
+}
+
+/**
+ * @brief Get the value from the top of a non-empty stack.
+ *
+ * @param[in] self              The stack pointer.
+ *
+ * @return                      The top value.
+ */
+static inline VALUE_TYPE JOIN(STACK_NAME, get_top)(const STACK_TYPE *self)
+{
+    assert(self != NULL);
+    assert(STACK_IS_EMPTY(self) == false);
+
+    return self->values[self->count - 1];
+}
+
+/**
+ * @brief Get the value from the bottom of a non-empty stack.
+ *
+ * @param[in] self              The stack pointer.
+ *
+ * @return                      The bottom value.
+ */
+static inline VALUE_TYPE JOIN(STACK_NAME, get_bottom)(const STACK_TYPE *self)
+{
+    assert(self != NULL);
+    assert(STACK_IS_EMPTY(self) == false);
+
+    return self->values[0];
+}
+
+/**
+ * @brief Peek a non-empty stack and get it's next to-be-popped value.
+ *
+ * @param[in] self              The stack pointer.
+ *
+ * @return                      The next to-be-popped value.
+ */
+static inline VALUE_TYPE JOIN(STACK_NAME, peek)(const STACK_TYPE *self)
+{
+    return JOIN(STACK_NAME, get_top)(self);
+}
+
+/**
+ * @brief Push a value onto the stack. Grows the stack if it is full.
+ *
+ * @param[in] self              The stack pointer.
+ * @param[in] value             The value.
+ *
+ * @return                      Whether the value was pushed.
+ * @retval false                If the stack was full and growing it failed.
+ */
+static inline bool JOIN(STACK_NAME, push)(STACK_TYPE *self, VALUE_TYPE const value)
+{
+    assert(self != NULL);
+
+    if (STACK_IS_FULL(self) && !STACK_GROW(self)) {
+        return false;
+    }
+
+    self->values[self->count++] = value;
+
+    return true;
+}
+
+/**
+ * @brief Pop a value away from a non-empty stack.
+ *
+ * @param[in] self              The stack pointer.
+ *
+ * @return                      The top value.
+ */
+static inline VALUE_TYPE JOIN(STACK_NAME, pop)(STACK_TYPE *self)
+{
+    assert(self != NULL);
+    assert(STACK_IS_EMPTY(self) == false);
+
+    return self->values[--self->count];
+}
+
+/**
+ * @brief Clear the elements in the stack. The capacity is kept.
+ *
+ * @param[in] self              The stack pointer.
+ */
+static inline void JOIN(STACK_NAME, clear)(STACK_TYPE *self)
+{
+    assert(self != NULL);
+
+    self->count = 0;
+}
+
+/**
+ * @brief Copy the values from a source stack to a destination stack. The
+ *        destination is grown if needed.
+ *
+ * @param[in,out] dest_ptr      The destination stack.
+ * @param[in] src_ptr           The source stack.
+ *
+ * @return                      Whether the values were copied.
+ * @retval false                If growing the destination failed.
+ */
+static inline bool JOIN(STACK_NAME, copy)(STACK_TYPE *restrict dest_ptr, const STACK_TYPE *restrict src_ptr)
+{
+    assert(src_ptr != NULL);
+    assert(dest_ptr != NULL);
+    assert(STACK_IS_EMPTY(dest_ptr));
+
+    if (!STACK_RESERVE(dest_ptr, src_ptr->count)) {
+        return false;
+    }
+
+    memcpy(&dest_ptr->values[0], &src_ptr->values[0], src_ptr->count * sizeof(VALUE_TYPE));
+
+    dest_ptr->count = src_ptr->count;
+
+    return true;
+}
+
+// }}}
+
+// macro undefs: {{{
+
+#undef NAME
+#undef VALUE_TYPE
+
+#undef STACK_NAME
+#undef STACK_TYPE
+#undef STACK_IS_EMPTY
+#undef STACK_IS_FULL
+#undef STACK_RESERVE
+#undef STACK_GROW
+
+// }}}
+
+// vim: ft=c fdm=marker
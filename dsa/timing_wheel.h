@@ -0,0 +1,289 @@
+/*  timing_wheel.h
+ *
+ *  Copyright (C) 2023 abxh
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *  See the file LICENSE included with this distribution for more
+ *  information. */
+
+/**
+ * @file timing_wheel.h
+ * @brief Intrusive hierarchical timing wheel
+ *
+ * Timers are embedded in user structs, and linked into slots with
+ * `list_node`s. Scheduling and cancelling a timer is O(1). Advancing the
+ * wheel collects the expired timers of each tick in a batch.
+ *
+ * The wheel has `TIMING_WHEEL_LEVELS` levels of `TIMING_WHEEL_SLOT_COUNT`
+ * slots. A slot at level `i` spans `TIMING_WHEEL_SLOT_COUNT^i` ticks. When the
+ * slot index of a level wraps around, the timers of the next slot of the level
+ * above are cascaded down. Timers further away than the wheel spans are placed
+ * in the furthest slot of the top level, and cascaded until they are in range.
+ *
+ * Define `TIMING_WHEEL_LEVELS` / `TIMING_WHEEL_SLOT_BITS` before including
+ * this header to change the defaults.
+ *
+ * Sources used:
+ * @li http://www.cs.columbia.edu/~nahum/w6998/papers/sosp87-timing-wheels.pdf
+ * @li https://lwn.net/Articles/646950/
+ */
+
+/**
+ * @example tests/timing_wheel/timing_wheel.c
+ * Examples of how `timing_wheel.h` header file is used in practice.
+ */
+
+#pragma once
+
+#include "list.h" // list_node, list_node_init, list_node_add_before, list_node_remove
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @def TIMING_WHEEL_LEVELS
+ * @brief Number of levels in the wheel. Defaults to 4.
+ */
+#ifndef TIMING_WHEEL_LEVELS
+#define TIMING_WHEEL_LEVELS (4U)
+#endif
+
+/**
+ * @def TIMING_WHEEL_SLOT_BITS
+ * @brief Number of bits of the tick used to index a slot at each level.
+ *        Defaults to 6.
+ */
+#ifndef TIMING_WHEEL_SLOT_BITS
+#define TIMING_WHEEL_SLOT_BITS (6U)
+#endif
+
+/**
+ * @def TIMING_WHEEL_SLOT_COUNT
+ * @brief Number of slots at each level.
+ */
+#define TIMING_WHEEL_SLOT_COUNT (1U << TIMING_WHEEL_SLOT_BITS)
+
+static_assert(TIMING_WHEEL_LEVELS * TIMING_WHEEL_SLOT_BITS < 64, "The wheel must span less than 2^64 ticks.");
+
+/// @cond DO_NOT_DOCUMENT
+#define TIMING_WHEEL_SLOT_MASK (TIMING_WHEEL_SLOT_COUNT - 1U)
+/// @endcond
+
+/**
+ * @brief Intrusive timer struct. Embed it in a struct, and use
+ *        `list_node_entry` on the `node` member (or `container_of` on the
+ *        timer) to get the struct back.
+ */
+struct timing_wheel_timer {
+    struct list_node node; ///< Slot list node. Points to itself when the timer is not scheduled.
+    uint64_t expires;      ///< Tick the timer expires at.
+};
+
+/**
+ * @brief Timing wheel struct.
+ */
+struct timing_wheel {
+    uint64_t now;                                                       ///< Current tick.
+    uint32_t count;                                                     ///< Number of scheduled timers.
+    struct list_node slots[TIMING_WHEEL_LEVELS][TIMING_WHEEL_SLOT_COUNT]; ///< Slot list heads.
+};
+
+/// @cond DO_NOT_DOCUMENT
+
+/* link a timer into the slot given by its expiry, relative to the current tick */
+static inline void internal_timing_wheel_insert(struct timing_wheel *self, struct timing_wheel_timer *timer)
+{
+    assert(timer->expires >= self->now);
+
+    const uint64_t expires = timer->expires;
+    const uint64_t delta = expires - self->now;
+
+    uint32_t level = 0;
+    while (level + 1 < TIMING_WHEEL_LEVELS && delta >= (uint64_t)1 << ((level + 1) * TIMING_WHEEL_SLOT_BITS)) {
+        level++;
+    }
+
+    uint64_t slot_tick = expires;
+    if (delta >= (uint64_t)1 << (TIMING_WHEEL_LEVELS * TIMING_WHEEL_SLOT_BITS)) {
+        /* out of range. placed in the furthest top level slot, and cascaded from there */
+        slot_tick = self->now + ((uint64_t)TIMING_WHEEL_SLOT_MASK << (level * TIMING_WHEEL_SLOT_BITS));
+    }
+
+    const uint64_t slot = (slot_tick >> (level * TIMING_WHEEL_SLOT_BITS)) & TIMING_WHEEL_SLOT_MASK;
+
+    list_node_add_before(&timer->node, &self->slots[level][slot]);
+}
+
+/* re-insert the timers of the current slot at a level above 0 */
+static inline void internal_timing_wheel_cascade(struct timing_wheel *self, const uint32_t level)
+{
+    const uint64_t slot = (self->now >> (level * TIMING_WHEEL_SLOT_BITS)) & TIMING_WHEEL_SLOT_MASK;
+    struct list_node *head = &self->slots[level][slot];
+
+    while (head->next_ptr != head) {
+        struct list_node *node = list_node_remove(head->next_ptr);
+        struct timing_wheel_timer *timer = list_node_entry(node, struct timing_wheel_timer, node);
+
+        internal_timing_wheel_insert(self, timer);
+    }
+}
+
+/// @endcond
+
+/**
+ * @brief Initialize a timer. Must be done once before it is scheduled.
+ *
+ * @param[in] timer             The timer pointer.
+ */
+static inline void timing_wheel_timer_init(struct timing_wheel_timer *timer)
+{
+    assert(timer);
+
+    list_node_init(&timer->node);
+    timer->expires = 0;
+}
+
+/**
+ * @brief Return whether a timer is scheduled.
+ *
+ * @note An expired timer is still linked, and thus reported as scheduled,
+ *       until it is removed from the list given to `timing_wheel_advance`.
+ *
+ * @param[in] timer             The timer pointer.
+ *
+ * @return                      Whether the timer is scheduled.
+ */
+static inline bool timing_wheel_timer_is_scheduled(const struct timing_wheel_timer *timer)
+{
+    assert(timer);
+
+    return timer->node.next_ptr != &timer->node;
+}
+
+/**
+ * @brief Initialize a timing wheel at a given tick.
+ *
+ * @param[in] self              The timing wheel pointer.
+ * @param[in] now               The current tick.
+ */
+static inline void timing_wheel_init(struct timing_wheel *self, const uint64_t now)
+{
+    assert(self);
+
+    self->now = now;
+    self->count = 0;
+
+    for (uint32_t level = 0; level < TIMING_WHEEL_LEVELS; level++) {
+        for (uint32_t slot = 0; slot < TIMING_WHEEL_SLOT_COUNT; slot++) {
+            list_node_init(&self->slots[level][slot]);
+        }
+    }
+}
+
+/**
+ * @brief Schedule a timer to expire at a given tick.
+ *
+ * A timer that expires at or before the current tick is set to expire at the
+ * next tick.
+ *
+ * @param[in] self              The timing wheel pointer.
+ * @param[in] timer             The timer pointer. Must not already be scheduled.
+ * @param[in] expires           The tick the timer expires at.
+ */
+static inline void timing_wheel_schedule(struct timing_wheel *self, struct timing_wheel_timer *timer,
+                                         const uint64_t expires)
+{
+    assert(self);
+    assert(timer);
+    assert(!timing_wheel_timer_is_scheduled(timer) && "timer already scheduled!");
+
+    timer->expires = expires > self->now ? expires : self->now + 1;
+
+    internal_timing_wheel_insert(self, timer);
+
+    self->count++;
+}
+
+/**
+ * @brief Cancel a scheduled timer.
+ *
+ * @warning A timer which is moved to the expired list by
+ *          `timing_wheel_advance` must not be cancelled. It is no longer
+ *          counted by the wheel. Remove it from the list with
+ *          `list_node_remove` instead.
+ *
+ * @param[in] self              The timing wheel pointer.
+ * @param[in] timer             The timer pointer. Must be scheduled, and not expired.
+ */
+static inline void timing_wheel_cancel(struct timing_wheel *self, struct timing_wheel_timer *timer)
+{
+    assert(self);
+    assert(timer);
+    assert(timing_wheel_timer_is_scheduled(timer) && "timer not scheduled!");
+    assert(timer->expires > self->now && "timer already expired!");
+
+    list_node_remove(&timer->node);
+
+    self->count--;
+}
+
+/**
+ * @brief Advance the wheel to a given tick, and move the timers expiring on
+ *        the way to a list.
+ *
+ * The expired timers are no longer counted by the wheel, and are no longer
+ * scheduled once their nodes are removed from the list. They are appended in
+ * order of expiry. The order of timers expiring at the same tick is
+ * unspecified.
+ *
+ * @param[in] self              The timing wheel pointer.
+ * @param[in] now               The tick to advance to. Must not be less than the current tick.
+ * @param[in] expired_head      The head of the list to append the expired timers to.
+ *
+ * @return                      The number of expired timers.
+ */
+static inline uint32_t timing_wheel_advance(struct timing_wheel *self, const uint64_t now,
+                                            struct list_node *expired_head)
+{
+    assert(self);
+    assert(expired_head);
+    assert(now >= self->now);
+
+    uint32_t expired_count = 0;
+
+    while (self->now < now) {
+        if (self->count == 0) {
+            self->now = now;
+            break;
+        }
+
+        self->now++;
+
+        for (uint32_t level = 1; level < TIMING_WHEEL_LEVELS; level++) {
+            if ((self->now & (((uint64_t)1 << (level * TIMING_WHEEL_SLOT_BITS)) - 1)) != 0) {
+                break;
+            }
+            internal_timing_wheel_cascade(self, level);
+        }
+
+        struct list_node *head = &self->slots[0][self->now & TIMING_WHEEL_SLOT_MASK];
+
+        while (head->next_ptr != head) {
+            struct list_node *node = list_node_remove(head->next_ptr);
+
+            list_node_add_before(node, expired_head);
+
+            self->count--;
+            expired_count++;
+        }
+    }
+
+    return expired_count;
+}
+
+// vim: ft=c
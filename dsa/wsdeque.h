@@ -0,0 +1,383 @@
+/*  wsdeque.h
+ *
+ *  Copyright (C) 2023 abxh
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *  See the file LICENSE included with this distribution for more
+ *  information. */
+
+/**
+ * @file wsdeque.h
+ * @brief Growable work-stealing deque (Chase-Lev)
+ *
+ * A deque owned by a single thread, which pushes and pops values at the
+ * bottom (LIFO), while any other thread may steal values from the top (FIFO).
+ * `push` and `pop` only synchronize with thieves when the deque is nearly
+ * empty, and `steal` is a single compare-and-swap.
+ *
+ * The values are kept in a power-of-2 circular array, which the owner doubles
+ * in size when the deque is full. Thieves may still be reading the old array,
+ * so it is retired instead of freed, and freed when the deque is destroyed.
+ *
+ * `VALUE_TYPE` is read and written atomically, so it should be an integer or
+ * pointer type, for which the atomic operations are lock-free (e.g. a task
+ * pointer).
+ *
+ * The following macros must be defined:
+ *      @li `NAME`
+ *      @li `VALUE_TYPE`
+ *
+ * Sources used:
+ * @li https://www.dre.vanderbilt.edu/~schmidt/PDF/work-stealing-dequeue.pdf
+ * @li https://fzn.fr/readings/ppopp13.pdf
+ */
+
+// macro definitions: {{{
+
+#ifndef WSDEQUE_H
+#define WSDEQUE_H
+
+#include "is_pow2.h"       // is_pow2
+#include "paste.h"         // PASTE, XPASTE, JOIN
+#include "round_up_pow2.h" // round_up_pow2_32
+
+#include <assert.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#endif // WSDEQUE_H
+
+/**
+ * @def NAME
+ * @brief Prefix to deque type and operations. This must be manually defined
+ *        before including this header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef NAME
+#define NAME wsdeque
+#error "Must define NAME."
+#else
+#define WSDEQUE_NAME NAME
+#endif
+
+/**
+ * @def VALUE_TYPE
+ * @brief Deque value type. This must be manually defined before including this
+ *        header file.
+ *
+ * Is undefined after header is included.
+ */
+#ifndef VALUE_TYPE
+#define VALUE_TYPE int
+#error "Must define VALUE_TYPE."
+#endif
+
+/// @cond DO_NOT_DOCUMENT
+#define WSDEQUE_TYPE         struct WSDEQUE_NAME
+#define WSDEQUE_ARRAY_TYPE   struct JOIN(WSDEQUE_NAME, array)
+#define WSDEQUE_ARRAY_CREATE JOIN(internal, JOIN(WSDEQUE_NAME, array_create))
+#define WSDEQUE_GROW         JOIN(internal, JOIN(WSDEQUE_NAME, grow))
+/// @endcond
+
+// }}}
+
+// type definitions: {{{
+
+/**
+ * @brief Generated circular array struct type for a `VALUE_TYPE`.
+ */
+struct JOIN(WSDEQUE_NAME, array) {
+    int64_t capacity;              ///< Number of values allocated for. A power of 2.
+    WSDEQUE_ARRAY_TYPE *prev_ptr;  ///< Previous (retired) array, or NULL.
+    _Atomic(VALUE_TYPE) values[];  ///< Array of values.
+};
+
+/**
+ * @brief Generated deque struct type for a `VALUE_TYPE`.
+ */
+struct WSDEQUE_NAME {
+    alignas(64) _Atomic int64_t top;                   ///< Index of the top value. Incremented by thieves.
+    alignas(64) _Atomic int64_t bottom;                ///< Index past the bottom value. Only written by the owner.
+    alignas(64) _Atomic(WSDEQUE_ARRAY_TYPE *) array_ptr; ///< Current circular array.
+};
+
+// }}}
+
+// function definitions: {{{
+
+/// @cond DO_NOT_DOCUMENT
+static inline WSDEQUE_ARRAY_TYPE *JOIN(internal, JOIN(WSDEQUE_NAME, array_create))(const int64_t capacity)
+{
+    assert(capacity > 0 && is_pow2((size_t)capacity));
+
+    WSDEQUE_ARRAY_TYPE *array =
+        (WSDEQUE_ARRAY_TYPE *)malloc(offsetof(WSDEQUE_ARRAY_TYPE, values) + (size_t)capacity * sizeof(array->values[0]));
+
+    if (!array) {
+        return NULL;
+    }
+
+    array->capacity = capacity;
+    array->prev_ptr = NULL;
+
+    return array;
+}
+
+/* double the capacity of the array, copying the values between top and bottom. only called by the owner */
+static inline WSDEQUE_ARRAY_TYPE *JOIN(internal, JOIN(WSDEQUE_NAME, grow))(WSDEQUE_TYPE *self,
+                                                                           WSDEQUE_ARRAY_TYPE *array,
+                                                                           const int64_t top, const int64_t bottom)
+{
+    if (array->capacity > INT64_MAX / 2) {
+        return NULL;
+    }
+
+    WSDEQUE_ARRAY_TYPE *new_array = WSDEQUE_ARRAY_CREATE(2 * array->capacity);
+
+    if (!new_array) {
+        return NULL;
+    }
+
+    for (int64_t i = top; i < bottom; i++) {
+        VALUE_TYPE const value = atomic_load_explicit(&array->values[i & (array->capacity - 1)], memory_order_relaxed);
+        atomic_store_explicit(&new_array->values[i & (new_array->capacity - 1)], value, memory_order_relaxed);
+    }
+    new_array->prev_ptr = array;
+
+    atomic_store_explicit(&self->array_ptr, new_array, memory_order_release);
+
+    return new_array;
+}
+/// @endcond
+
+/**
+ * @brief Create a deque struct with a given initial capacity with
+ *        aligned_alloc().
+ *
+ * @param[in] min_capacity      Number of values expected to be stored initially. Rounded up to a power of 2.
+ *
+ * @return                      A pointer to the deque.
+ * @retval NULL
+ *   @li                        If malloc / aligned_alloc fails.
+ *   @li                        If capacity is 0 or larger than UINT32_MAX / 2 + 1.
+ */
+static inline WSDEQUE_TYPE *JOIN(WSDEQUE_NAME, create)(const uint32_t min_capacity)
+{
+    if (min_capacity == 0 || min_capacity > UINT32_MAX / 2 + 1) {
+        return NULL;
+    }
+
+    WSDEQUE_TYPE *self = (WSDEQUE_TYPE *)aligned_alloc(alignof(WSDEQUE_TYPE), sizeof(WSDEQUE_TYPE));
+
+    if (!self) {
+        return NULL;
+    }
+
+    WSDEQUE_ARRAY_TYPE *array = WSDEQUE_ARRAY_CREATE((int64_t)round_up_pow2_32(min_capacity));
+
+    if (!array) {
+        free(self);
+        return NULL;
+    }
+
+    atomic_init(&self->top, 0);
+    atomic_init(&self->bottom, 0);
+    atomic_init(&self->array_ptr, array);
+
+    return self;
+}
+
+/**
+ * @brief Destroy a deque struct and free the underlying memory with free().
+ *
+ * @warning May not be called twice in a row on the same object. Or while other
+ *          threads are using the deque.
+ *
+ * @param[in] self              The deque pointer.
+ */
+static inline void JOIN(WSDEQUE_NAME, destroy)(WSDEQUE_TYPE *self)
+{
+    assert(self != NULL);
+
+    WSDEQUE_ARRAY_TYPE *array = atomic_load_explicit(&self->array_ptr, memory_order_relaxed);
+
+    while (array) {
+        WSDEQUE_ARRAY_TYPE *prev_array = array->prev_ptr;
+        free(array);
+        array = prev_array;
+    }
+
+    free(self);
+}
+
+/**
+ * @brief Return the number of values in the deque.
+ *
+ * @note The count is only a snapshot, when other threads are using the deque.
+ *
+ * @param[in] self              The deque pointer.
+ *
+ * @return                      The number of values.
+ */
+static inline uint32_t JOIN(WSDEQUE_NAME, count)(WSDEQUE_TYPE *self)
+{
+    assert(self != NULL);
+
+    const int64_t bottom = atomic_load_explicit(&self->bottom, memory_order_relaxed);
+    const int64_t top = atomic_load_explicit(&self->top, memory_order_relaxed);
+
+    return bottom > top ? (uint32_t)(bottom - top) : 0;
+}
+
+/**
+ * @brief Return whether the deque is empty.
+ *
+ * @note The result is only a snapshot, when other threads are using the deque.
+ *
+ * @param[in] self              The deque pointer.
+ *
+ * @return                      Whether the deque is empty.
+ */
+static inline bool JOIN(WSDEQUE_NAME, is_empty)(WSDEQUE_TYPE *self)
+{
+    return JOIN(WSDEQUE_NAME, count)(self) == 0;
+}
+
+/**
+ * @brief Push a value at the bottom of the deque. Grows the deque if it is
+ *        full. May only be called by the owner thread.
+ *
+ * @param[in] self              The deque pointer.
+ * @param[in] value             The value to push.
+ *
+ * @return                      Whether the value was pushed.
+ * @retval false                If the deque was full and growing it failed.
+ */
+static inline bool JOIN(WSDEQUE_NAME, push)(WSDEQUE_TYPE *self, VALUE_TYPE const value)
+{
+    assert(self != NULL);
+
+    const int64_t bottom = atomic_load_explicit(&self->bottom, memory_order_relaxed);
+    const int64_t top = atomic_load_explicit(&self->top, memory_order_acquire);
+    WSDEQUE_ARRAY_TYPE *array = atomic_load_explicit(&self->array_ptr, memory_order_relaxed);
+
+    if (bottom - top > array->capacity - 1) {
+        array = WSDEQUE_GROW(self, array, top, bottom);
+
+        if (!array) {
+            return false;
+        }
+    }
+
+    atomic_store_explicit(&array->values[bottom & (array->capacity - 1)], value, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&self->bottom, bottom + 1, memory_order_relaxed);
+
+    return true;
+}
+
+/**
+ * @brief Pop a value from the bottom of the deque. May only be called by the
+ *        owner thread.
+ *
+ * @param[in] self              The deque pointer.
+ * @param[out] value_ptr        Where the popped value is stored.
+ *
+ * @return                      Whether a value was popped.
+ * @retval false                If the deque was empty, or the last value was stolen.
+ */
+static inline bool JOIN(WSDEQUE_NAME, pop)(WSDEQUE_TYPE *self, VALUE_TYPE *value_ptr)
+{
+    assert(self != NULL);
+    assert(value_ptr != NULL);
+
+    const int64_t bottom = atomic_load_explicit(&self->bottom, memory_order_relaxed) - 1;
+    WSDEQUE_ARRAY_TYPE *array = atomic_load_explicit(&self->array_ptr, memory_order_relaxed);
+
+    /* claim the bottom value before reading top, such that thieves see the claim */
+    atomic_store_explicit(&self->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    int64_t top = atomic_load_explicit(&self->top, memory_order_relaxed);
+
+    if (top > bottom) {
+        atomic_store_explicit(&self->bottom, bottom + 1, memory_order_relaxed);
+        return false;
+    }
+
+    *value_ptr = atomic_load_explicit(&array->values[bottom & (array->capacity - 1)], memory_order_relaxed);
+
+    if (top < bottom) {
+        return true;
+    }
+
+    /* the last value. race the thieves for it */
+    const bool won = atomic_compare_exchange_strong_explicit(&self->top, &top, top + 1, memory_order_seq_cst,
+                                                             memory_order_relaxed);
+
+    atomic_store_explicit(&self->bottom, bottom + 1, memory_order_relaxed);
+
+    return won;
+}
+
+/**
+ * @brief Steal a value from the top of the deque. May be called by any thread.
+ *
+ * @param[in] self              The deque pointer.
+ * @param[out] value_ptr        Where the stolen value is stored.
+ *
+ * @return                      Whether a value was stolen.
+ * @retval false                If the deque was empty, or another thread took the value first. Check `is_empty` to
+ *                              tell these apart.
+ */
+static inline bool JOIN(WSDEQUE_NAME, steal)(WSDEQUE_TYPE *self, VALUE_TYPE *value_ptr)
+{
+    assert(self != NULL);
+    assert(value_ptr != NULL);
+
+    int64_t top = atomic_load_explicit(&self->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    const int64_t bottom = atomic_load_explicit(&self->bottom, memory_order_acquire);
+
+    if (top >= bottom) {
+        return false;
+    }
+
+    WSDEQUE_ARRAY_TYPE *array = atomic_load_explicit(&self->array_ptr, memory_order_acquire);
+
+    VALUE_TYPE const value = atomic_load_explicit(&array->values[top & (array->capacity - 1)], memory_order_relaxed);
+
+    if (!atomic_compare_exchange_strong_explicit(&self->top, &top, top + 1, memory_order_seq_cst,
+                                                 memory_order_relaxed)) {
+        return false;
+    }
+
+    *value_ptr = value;
+
+    return true;
+}
+
+// }}}
+
+// macro undefs: {{{
+
+#undef NAME
+#undef VALUE_TYPE
+
+#undef WSDEQUE_NAME
+#undef WSDEQUE_TYPE
+#undef WSDEQUE_ARRAY_TYPE
+#undef WSDEQUE_ARRAY_CREATE
+#undef WSDEQUE_GROW
+
+// }}}
+
+// vim: ft=c fdm=marker
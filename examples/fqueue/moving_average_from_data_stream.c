@@ -2,59 +2,62 @@
 #include <float.h>
 #include <math.h>
 
-#define NAME       flt_queue
-#define VALUE_TYPE float
-#include "fqueue.h"
+#include "sliding_window.h"
 
 struct data_stream {
     float avg;
-    struct flt_queue *queue;
+    struct sliding_window *window;
 };
 
 static inline void data_stream_init(struct data_stream *s, uint32_t max_elm)
 {
-    s->avg = FP_NAN;
-    s->queue = flt_queue_create(max_elm);
+    s->avg = NAN;
+    s->window = sliding_window_create(max_elm);
 }
 
 static inline void data_stream_deinit(struct data_stream *s)
 {
-    flt_queue_destroy(s->queue);
+    sliding_window_destroy(s->window);
+}
+
+static inline void data_stream_update_avg(struct data_stream *s)
+{
+    s->avg = sliding_window_is_empty(s->window) ? NAN : (float)sliding_window_mean(s->window);
 }
 
 static inline void data_stream_enqueue(struct data_stream *s, float val)
 {
-    if (flt_queue_is_full(s->queue)) {
+    if (sliding_window_is_full(s->window)) {
         return;
     }
-    if (s->queue->count == 0) {
-        s->avg = val;
-    }
-    else {
-        s->avg = (s->avg * (float)s->queue->count + val) / (float)(s->queue->count + 1);
-    }
-    flt_queue_enqueue(s->queue, val);
+    sliding_window_push(s->window, val);
+    data_stream_update_avg(s);
 }
 
 static inline float data_stream_dequeue(struct data_stream *s)
 {
-    if (flt_queue_is_empty(s->queue)) {
-        return FP_NAN;
+    if (sliding_window_is_empty(s->window)) {
+        return NAN;
     }
-    s->avg = (s->avg * (float)(s->queue->count) - flt_queue_peek(s->queue)) / (float)(s->queue->count - 1);
-    return flt_queue_dequeue(s->queue);
+    const float val = (float)sliding_window_pop(s->window);
+    data_stream_update_avg(s);
+    return val;
 }
 
 static inline void data_stream_print(struct data_stream *s)
 {
     printf("stream: [");
-    if (!flt_queue_is_empty(s->queue)) {
-        printf(" %.2f", flt_queue_at(s->queue, 0));
+    if (!sliding_window_is_empty(s->window)) {
+        printf(" %.2f", sliding_window_queue_at(s->window->values, 0));
+    }
+    for (size_t i = 1; i < s->window->values->count; i++) {
+        printf(", %.2f", sliding_window_queue_at(s->window->values, (uint32_t)i));
     }
-    for (size_t i = 1; i < s->queue->count; i++) {
-        printf(", %.2f", flt_queue_at(s->queue, (uint32_t)i));
+    printf(" ]");
+    if (!sliding_window_is_empty(s->window)) {
+        printf(" min: %.2f max: %.2f", sliding_window_min(s->window), sliding_window_max(s->window));
     }
-    printf(" ]\n");
+    printf("\n");
 }
 
 static inline bool float_is_nearly_equal(const float a, const float b, const uint16_t n)
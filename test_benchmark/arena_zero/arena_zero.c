@@ -0,0 +1,96 @@
+#include "arena.h"
+#include "pool.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BUF_LEN         ((size_t)64 * 1024 * 1024)
+#define TOTAL_BYTES     ((size_t)16 * 1024 * 1024 * 1024)
+#define POOL_CHUNK_SIZE ((size_t)4096)
+
+/* the chunks are written to right after allocation. called through a volatile pointer, such that the compiler can't
+ * elide the zeroing as a dead store */
+static void *(*volatile fill_fn)(void *, int, size_t) = memset;
+
+static double elapsed_ms(const struct timespec start, const struct timespec end)
+{
+    return (double)(end.tv_sec - start.tv_sec) * 1e+3 + (double)(end.tv_nsec - start.tv_nsec) / 1e+6;
+}
+
+static double benchmark_arena(struct arena *arena_p, void *(*allocate_fn)(struct arena *, size_t), const size_t size)
+{
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (size_t bytes = 0; bytes < TOTAL_BYTES; bytes += BUF_LEN) {
+        arena_deallocate_all(arena_p);
+
+        unsigned char *ptr;
+        while ((ptr = allocate_fn(arena_p, size)) != NULL) {
+            fill_fn(ptr, 0xab, size);
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return elapsed_ms(start, end);
+}
+
+static double benchmark_pool(struct pool *pool_p, void *(*allocate_fn)(struct pool *))
+{
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (size_t bytes = 0; bytes < TOTAL_BYTES; bytes += BUF_LEN) {
+        pool_deallocate_all(pool_p);
+
+        unsigned char *ptr;
+        while ((ptr = allocate_fn(pool_p)) != NULL) {
+            fill_fn(ptr, 0xab, POOL_CHUNK_SIZE);
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return elapsed_ms(start, end);
+}
+
+int main(void)
+{
+    unsigned char *buf = malloc(BUF_LEN);
+    if (!buf) {
+        return 1;
+    }
+    memset(buf, 0, BUF_LEN);
+
+    struct arena arena;
+    arena_init(&arena, BUF_LEN, buf);
+
+    const double gib = (double)TOTAL_BYTES / (1024.0 * 1024.0 * 1024.0);
+
+    for (size_t size = 64; size <= BUF_LEN / 4; size *= 16) {
+        const double zeroed_ms = benchmark_arena(&arena, arena_allocate, size);
+        const double uninit_ms = benchmark_arena(&arena, arena_allocate_uninit, size);
+
+        printf("time elapsed for allocating and writing %.0f GiB in %zu byte chunks with arena.h:\n", gib, size);
+        printf(" arena_allocate:        %.1f ms (%.1f GiB/s)\n", zeroed_ms, gib / zeroed_ms * 1e+3);
+        printf(" arena_allocate_uninit: %.1f ms (%.1f GiB/s)\n", uninit_ms, gib / uninit_ms * 1e+3);
+    }
+
+    struct pool pool;
+    pool_init(&pool, BUF_LEN, buf, POOL_CHUNK_SIZE, alignof(max_align_t));
+    {
+        const double zeroed_ms = benchmark_pool(&pool, pool_allocate);
+        const double uninit_ms = benchmark_pool(&pool, pool_allocate_uninit);
+
+        printf("time elapsed for allocating and writing %.0f GiB in %zu byte chunks with pool.h:\n", gib,
+               POOL_CHUNK_SIZE);
+        printf(" pool_allocate:         %.1f ms (%.1f GiB/s)\n", zeroed_ms, gib / zeroed_ms * 1e+3);
+        printf(" pool_allocate_uninit:  %.1f ms (%.1f GiB/s)\n", uninit_ms, gib / uninit_ms * 1e+3);
+    }
+
+    free(buf);
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+extern "C" {
+
+#ifdef __cplusplus
+#ifdef __GNUC__
+#define restrict __restrict__
+#else
+#define restrict
+#endif
+#endif
+
+#define NAME       u32_pque2
+#define VALUE_TYPE uint32_t
+#define ARITY      2
+#include "fpqueue.h"
+
+#define NAME       u32_pque4
+#define VALUE_TYPE uint32_t
+#define ARITY      4
+#include "fpqueue.h"
+
+#define NAME       u32_pque8
+#define VALUE_TYPE uint32_t
+#define ARITY      8
+#include "fpqueue.h"
+}
+
+#define BENCHMARK(pque_name)                                                                                      \
+    static void benchmark_##pque_name(const std::vector<uint32_t> &priorities, int64_t &push_us, int64_t &pop_us) \
+    {                                                                                                             \
+        using std::chrono::duration_cast;                                                                         \
+        using std::chrono::high_resolution_clock;                                                                 \
+        using std::chrono::microseconds;                                                                          \
+                                                                                                                  \
+        struct pque_name *pque_p = pque_name##_create((uint32_t)priorities.size());                               \
+                                                                                                                  \
+        auto c_start = high_resolution_clock::now();                                                              \
+        for (const uint32_t priority : priorities) {                                                              \
+            pque_name##_push(pque_p, priority, priority);                                                         \
+        }                                                                                                         \
+        auto c_mid = high_resolution_clock::now();                                                                \
+        uint32_t checksum = 0;                                                                                    \
+        while (!pque_name##_is_empty(pque_p)) {                                                                   \
+            checksum += pque_name##_pop_max(pque_p);                                                              \
+        }                                                                                                         \
+        auto c_end = high_resolution_clock::now();                                                                \
+                                                                                                                  \
+        pque_name##_destroy(pque_p);                                                                              \
+                                                                                                                  \
+        push_us = duration_cast<microseconds>(c_mid - c_start).count();                                           \
+        pop_us = duration_cast<microseconds>(c_end - c_mid).count();                                              \
+        if (checksum == 42) {                                                                                     \
+            std::cout << "";                                                                                      \
+        }                                                                                                         \
+    }
+
+BENCHMARK(u32_pque2)
+BENCHMARK(u32_pque4)
+BENCHMARK(u32_pque8)
+
+int main(void)
+{
+    srand(time(NULL));
+
+    for (size_t N = 1000; N <= 10000000; N *= 10) {
+        std::vector<uint32_t> priorities(N);
+        for (size_t i = 0; i < N; i++) {
+            priorities[i] = (uint32_t)rand();
+        }
+
+        int64_t push_us[3], pop_us[3];
+        benchmark_u32_pque2(priorities, push_us[0], pop_us[0]);
+        benchmark_u32_pque4(priorities, push_us[1], pop_us[1]);
+        benchmark_u32_pque8(priorities, push_us[2], pop_us[2]);
+
+        std::cout << "time elapsed for " << N << " elements (push / pop_max):" << std::endl;
+        std::cout << " ARITY = 2: " << push_us[0] << " μs / " << pop_us[0] << " μs" << std::endl;
+        std::cout << " ARITY = 4: " << push_us[1] << " μs / " << pop_us[1] << " μs" << std::endl;
+        std::cout << " ARITY = 8: " << push_us[2] << " μs / " << pop_us[2] << " μs" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,196 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+extern "C" {
+
+#ifdef __cplusplus
+#ifdef __GNUC__
+#define restrict __restrict__
+#else
+#define restrict
+#endif
+#endif
+
+struct large_value {
+    uint32_t data[16];
+};
+
+#define NAME       large_pque
+#define VALUE_TYPE struct large_value
+#include "fpqueue.h"
+}
+
+using element_type = struct large_pque_element;
+
+/* element moves made per pop_max, counting a swap as three moves */
+static uint64_t moves;
+
+/* the previous swap-based, recursive pop_max */
+static void swap_downheap(struct large_pque *self, const uint32_t index)
+{
+    const uint32_t l = 2 * index + 1;
+    const uint32_t r = 2 * index + 2;
+
+    uint32_t largest = index;
+    if (l < self->count && self->elements[l].priority > self->elements[largest].priority) {
+        largest = l;
+    }
+    if (r < self->count && self->elements[r].priority > self->elements[largest].priority) {
+        largest = r;
+    }
+    if (largest == index) {
+        return;
+    }
+
+    std::swap(self->elements[index], self->elements[largest]);
+    moves += 3;
+
+    swap_downheap(self, largest);
+}
+
+static struct large_value swap_pop_max(struct large_pque *self)
+{
+    const struct large_value max_priority_value = self->elements[0].value;
+
+    self->elements[0] = self->elements[self->count - 1];
+    moves++;
+
+    self->count--;
+
+    swap_downheap(self, 0);
+
+    return max_priority_value;
+}
+
+/* hole-based pop_max, comparing against the last element on the way down */
+static struct large_value hole_pop_max(struct large_pque *self)
+{
+    const struct large_value max_priority_value = self->elements[0].value;
+
+    self->count--;
+
+    const element_type last = self->elements[self->count];
+    uint32_t index = 0;
+
+    while (2 * index + 1 < self->count) {
+        uint32_t largest = 2 * index + 1;
+        if (largest + 1 < self->count && self->elements[largest + 1].priority > self->elements[largest].priority) {
+            largest++;
+        }
+        if (last.priority >= self->elements[largest].priority) {
+            break;
+        }
+        self->elements[index] = self->elements[largest];
+        moves++;
+        index = largest;
+    }
+
+    self->elements[index] = last;
+    moves++;
+
+    return max_priority_value;
+}
+
+/* hole-based pop_max, descending to a leaf first (same as the header) */
+static struct large_value bottom_up_pop_max(struct large_pque *self)
+{
+    const struct large_value max_priority_value = self->elements[0].value;
+
+    self->count--;
+
+    const element_type last = self->elements[self->count];
+    uint32_t index = 0;
+
+    while (2 * index + 1 < self->count) {
+        uint32_t largest = 2 * index + 1;
+        if (largest + 1 < self->count && self->elements[largest + 1].priority > self->elements[largest].priority) {
+            largest++;
+        }
+        self->elements[index] = self->elements[largest];
+        moves++;
+        index = largest;
+    }
+
+    while (index > 0 && self->elements[(index - 1) / 2].priority < last.priority) {
+        self->elements[index] = self->elements[(index - 1) / 2];
+        moves++;
+        index = (index - 1) / 2;
+    }
+
+    self->elements[index] = last;
+    moves++;
+
+    return max_priority_value;
+}
+
+template <typename PopMax>
+static int64_t benchmark(const std::vector<uint32_t> &priorities, PopMax pop_max)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::high_resolution_clock;
+    using std::chrono::microseconds;
+
+    struct large_pque *pque_p = large_pque_create((uint32_t)priorities.size());
+
+    for (const uint32_t priority : priorities) {
+        large_pque_push(pque_p, (struct large_value){{priority}}, priority);
+    }
+
+    uint32_t checksum = 0;
+    auto c_start = high_resolution_clock::now();
+    while (!large_pque_is_empty(pque_p)) {
+        checksum += pop_max(pque_p).data[0];
+    }
+    auto c_end = high_resolution_clock::now();
+
+    large_pque_destroy(pque_p);
+
+    if (checksum == 42) {
+        std::cout << "";
+    }
+
+    return duration_cast<microseconds>(c_end - c_start).count();
+}
+
+int main(void)
+{
+    srand(time(NULL));
+
+    for (size_t N = 1000; N <= 10000000; N *= 10) {
+        std::vector<uint32_t> priorities(N);
+        for (size_t i = 0; i < N; i++) {
+            priorities[i] = (uint32_t)rand();
+        }
+
+        moves = 0;
+        benchmark(priorities, swap_pop_max);
+        const double swap_moves = (double)moves / (double)N;
+
+        moves = 0;
+        benchmark(priorities, hole_pop_max);
+        const double hole_moves = (double)moves / (double)N;
+
+        moves = 0;
+        benchmark(priorities, bottom_up_pop_max);
+        const double bottom_up_moves = (double)moves / (double)N;
+
+        const int64_t swap_us = benchmark(priorities, swap_pop_max);
+        const int64_t pque_us = benchmark(priorities, large_pque_pop_max);
+
+        std::cout << "element moves per pop_max for " << N << " elements:" << std::endl;
+        std::cout << " swap:      " << swap_moves << std::endl;
+        std::cout << " hole:      " << hole_moves << std::endl;
+        std::cout << " bottom-up: " << bottom_up_moves << std::endl;
+        std::cout << "time elapsed for " << N << " elements (pop_max, " << sizeof(element_type)
+                  << " byte elements):" << std::endl;
+        std::cout << " swap:      " << swap_us << " μs" << std::endl;
+        std::cout << " fpqueue.h: " << pque_us << " μs" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+extern "C" {
+
+#ifdef __cplusplus
+#ifdef __GNUC__
+#define restrict __restrict__
+#else
+#define restrict
+#endif
+#endif
+
+struct large_value {
+    uint32_t data[16];
+};
+
+#define NAME       aos_pque
+#define VALUE_TYPE struct large_value
+#define ARITY      8
+#include "fpqueue.h"
+
+#define NAME       soa_pque
+#define VALUE_TYPE struct large_value
+#define ARITY      8
+#include "fpqueue_soa.h"
+}
+
+#define BENCHMARK(pque_name)                                                                                      \
+    static void benchmark_##pque_name(const std::vector<uint32_t> &priorities, int64_t &push_us, int64_t &pop_us) \
+    {                                                                                                             \
+        using std::chrono::duration_cast;                                                                         \
+        using std::chrono::high_resolution_clock;                                                                 \
+        using std::chrono::microseconds;                                                                          \
+                                                                                                                  \
+        struct pque_name *pque_p = pque_name##_create((uint32_t)priorities.size());                               \
+                                                                                                                  \
+        auto c_start = high_resolution_clock::now();                                                              \
+        for (const uint32_t priority : priorities) {                                                              \
+            pque_name##_push(pque_p, (struct large_value){{priority}}, priority);                                 \
+        }                                                                                                         \
+        auto c_mid = high_resolution_clock::now();                                                                \
+        uint32_t checksum = 0;                                                                                    \
+        while (!pque_name##_is_empty(pque_p)) {                                                                   \
+            checksum += pque_name##_pop_max(pque_p).data[0];                                                      \
+        }                                                                                                         \
+        auto c_end = high_resolution_clock::now();                                                                \
+                                                                                                                  \
+        pque_name##_destroy(pque_p);                                                                              \
+                                                                                                                  \
+        push_us = duration_cast<microseconds>(c_mid - c_start).count();                                           \
+        pop_us = duration_cast<microseconds>(c_end - c_mid).count();                                              \
+        if (checksum == 42) {                                                                                     \
+            std::cout << "";                                                                                      \
+        }                                                                                                         \
+    }
+
+BENCHMARK(aos_pque)
+BENCHMARK(soa_pque)
+
+int main(void)
+{
+    srand(time(NULL));
+
+    for (size_t N = 1000; N <= 1000000; N *= 10) {
+        std::vector<uint32_t> priorities(N);
+        for (size_t i = 0; i < N; i++) {
+            priorities[i] = (uint32_t)rand();
+        }
+
+        int64_t push_us[2], pop_us[2];
+        benchmark_aos_pque(priorities, push_us[0], pop_us[0]);
+        benchmark_soa_pque(priorities, push_us[1], pop_us[1]);
+
+        std::cout << "time elapsed for " << N << " elements of " << sizeof(struct large_value)
+                  << " bytes (push / pop_max), ARITY = 8:" << std::endl;
+        std::cout << " fpqueue.h:     " << push_us[0] << " μs / " << pop_us[0] << " μs" << std::endl;
+        std::cout << " fpqueue_soa.h: " << push_us[1] << " μs / " << pop_us[1] << " μs" << std::endl;
+    }
+
+    return 0;
+}
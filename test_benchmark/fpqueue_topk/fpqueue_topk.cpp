@@ -0,0 +1,149 @@
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+
+extern "C" {
+
+#ifdef __cplusplus
+#ifdef __GNUC__
+#define restrict __restrict__
+#else
+#define restrict
+#endif
+#endif
+
+#define NAME                   u32_topk
+#define VALUE_TYPE             uint32_t
+#define PRIORITY_IS_LESS(a, b) ((a) > (b))
+#include "fpqueue.h"
+
+#define NAME       u32_pque
+#define VALUE_TYPE uint32_t
+#include "fpqueue.h"
+}
+
+/* the stream is generated on the fly, such that it does not have to fit in memory */
+static inline uint32_t xorshift32(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static const uint32_t K = 100;
+
+/* keep the top-K with push_bounded (single comparison rejection) */
+static uint64_t top_k_push_bounded(const uint64_t N, const uint32_t seed)
+{
+    struct u32_topk *topk_p = u32_topk_create(K);
+
+    uint32_t state = seed;
+    for (uint64_t i = 0; i < N; i++) {
+        const uint32_t x = xorshift32(&state);
+        u32_topk_push_bounded(topk_p, x, x);
+    }
+
+    const uint32_t count = u32_topk_drain_sorted(topk_p);
+
+    uint64_t checksum = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        checksum += topk_p->elements[i].value;
+    }
+
+    u32_topk_destroy(topk_p);
+
+    return checksum;
+}
+
+/* keep the top-K by pushing every element, and popping when over K */
+static uint64_t top_k_push_pop(const uint64_t N, const uint32_t seed)
+{
+    struct u32_topk *topk_p = u32_topk_create(K + 1);
+
+    uint32_t state = seed;
+    for (uint64_t i = 0; i < N; i++) {
+        const uint32_t x = xorshift32(&state);
+        u32_topk_push(topk_p, x, x);
+        if (topk_p->count > K) {
+            u32_topk_pop_max(topk_p);
+        }
+    }
+
+    uint64_t checksum = 0;
+    while (!u32_topk_is_empty(topk_p)) {
+        checksum += u32_topk_pop_max(topk_p);
+    }
+
+    u32_topk_destroy(topk_p);
+
+    return checksum;
+}
+
+/* push every element into a max-heap of size N, and pop K */
+static uint64_t top_k_full_heap(const uint64_t N, const uint32_t seed)
+{
+    struct u32_pque *pque_p = u32_pque_create((uint32_t)N);
+
+    uint32_t state = seed;
+    for (uint64_t i = 0; i < N; i++) {
+        const uint32_t x = xorshift32(&state);
+        u32_pque_push(pque_p, x, x);
+    }
+
+    uint64_t checksum = 0;
+    for (uint32_t i = 0; i < K; i++) {
+        checksum += u32_pque_pop_max(pque_p);
+    }
+
+    u32_pque_destroy(pque_p);
+
+    return checksum;
+}
+
+template <typename TopK>
+static int64_t benchmark(TopK top_k, const uint64_t N, const uint32_t seed, uint64_t *checksum)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::high_resolution_clock;
+    using std::chrono::microseconds;
+
+    auto c_start = high_resolution_clock::now();
+    *checksum = top_k(N, seed);
+    auto c_end = high_resolution_clock::now();
+
+    return duration_cast<microseconds>(c_end - c_start).count();
+}
+
+int main(void)
+{
+    const uint32_t seed = (uint32_t)time(NULL) | 1;
+
+    for (uint64_t N = 1000000; N <= 100000000; N *= 10) {
+        uint64_t bounded_checksum = 0;
+        uint64_t push_pop_checksum = 0;
+        uint64_t full_heap_checksum = 0;
+
+        const int64_t bounded_us = benchmark(top_k_push_bounded, N, seed, &bounded_checksum);
+        const int64_t push_pop_us = benchmark(top_k_push_pop, N, seed, &push_pop_checksum);
+
+        std::cout << "time elapsed for top-" << K << " of " << N << " elements:" << std::endl;
+        std::cout << " push_bounded:      " << bounded_us << " μs" << std::endl;
+        std::cout << " push + pop_max:    " << push_pop_us << " μs" << std::endl;
+
+        /* the full heap needs 8 bytes per element, so it is skipped for the largest stream */
+        if (N <= 10000000) {
+            const int64_t full_heap_us = benchmark(top_k_full_heap, N, seed, &full_heap_checksum);
+            std::cout << " full heap (N):     " << full_heap_us << " μs" << std::endl;
+        }
+
+        if (bounded_checksum != push_pop_checksum || (N <= 10000000 && bounded_checksum != full_heap_checksum)) {
+            std::cout << "checksum mismatch!" << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
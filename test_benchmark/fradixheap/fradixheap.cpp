@@ -0,0 +1,86 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+extern "C" {
+
+#ifdef __cplusplus
+#ifdef __GNUC__
+#define restrict __restrict__
+#else
+#define restrict
+#endif
+#endif
+
+#define NAME                   u64_pque
+#define VALUE_TYPE             uint64_t
+#define PRIORITY_TYPE          uint64_t
+#define PRIORITY_IS_LESS(a, b) ((a) > (b))
+#include "fpqueue.h"
+
+#define NAME       u64_rheap
+#define VALUE_TYPE uint64_t
+#define KEY_TYPE   uint64_t
+#include "fradixheap.h"
+}
+
+/* timer workload: N pending timers. the earliest timer is popped, and a new
+   timer is scheduled at the popped time plus a random timeout */
+#define BENCHMARK(heap_name, push_fn, pop_fn)                                                                         \
+    static int64_t benchmark_##heap_name(const std::vector<uint64_t> &timeouts, const size_t N, const size_t ops)     \
+    {                                                                                                                 \
+        using std::chrono::duration_cast;                                                                             \
+        using std::chrono::high_resolution_clock;                                                                     \
+        using std::chrono::microseconds;                                                                              \
+                                                                                                                      \
+        struct heap_name *heap_p = heap_name##_create((uint32_t)N);                                                   \
+                                                                                                                      \
+        for (size_t i = 0; i < N; i++) {                                                                              \
+            heap_name##_##push_fn(heap_p, timeouts[i], timeouts[i]);                                                  \
+        }                                                                                                             \
+                                                                                                                      \
+        auto c_start = high_resolution_clock::now();                                                                  \
+        uint64_t now = 0;                                                                                             \
+        for (size_t i = 0; i < ops; i++) {                                                                            \
+            now = heap_name##_##pop_fn(heap_p);                                                                       \
+            const uint64_t deadline = now + timeouts[i % timeouts.size()];                                            \
+            heap_name##_##push_fn(heap_p, deadline, deadline);                                                        \
+        }                                                                                                             \
+        auto c_end = high_resolution_clock::now();                                                                    \
+                                                                                                                      \
+        heap_name##_destroy(heap_p);                                                                                  \
+                                                                                                                      \
+        if (now == 42) {                                                                                              \
+            std::cout << "";                                                                                          \
+        }                                                                                                             \
+        return duration_cast<microseconds>(c_end - c_start).count();                                                  \
+    }
+
+BENCHMARK(u64_pque, push, pop_max)
+BENCHMARK(u64_rheap, push, pop_min)
+
+int main(void)
+{
+    srand(time(NULL));
+
+    const size_t ops = 10000000;
+
+    std::vector<uint64_t> timeouts(ops);
+    for (size_t i = 0; i < ops; i++) {
+        timeouts[i] = 1000000 + (uint64_t)rand() % 30000000000;
+    }
+
+    for (size_t N = 1000; N <= 1000000; N *= 10) {
+        const int64_t pque_us = benchmark_u64_pque(timeouts, N, ops);
+        const int64_t rheap_us = benchmark_u64_rheap(timeouts, N, ops);
+
+        std::cout << "time elapsed for " << ops << " (pop, push) with " << N << " pending timers:" << std::endl;
+        std::cout << " fpqueue.h:    " << pque_us << " μs" << std::endl;
+        std::cout << " fradixheap.h: " << rheap_us << " μs" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+extern "C" {
+
+#ifdef __cplusplus
+#ifdef __GNUC__
+#define restrict __restrict__
+#else
+#define restrict
+#endif
+#endif
+
+#define NAME       u64_stk
+#define VALUE_TYPE uint64_t
+#include "fstack.h"
+}
+
+/* push and pop runs of a given length, like a DFS pushing the children of a node */
+template <typename PushRun, typename PopRun>
+static int64_t benchmark(const uint32_t total, const uint32_t run_length, PushRun push_run, PopRun pop_run)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::high_resolution_clock;
+    using std::chrono::nanoseconds;
+
+    struct u64_stk *stk_p = u64_stk_create(1024);
+
+    std::vector<uint64_t> run(run_length);
+    for (uint32_t i = 0; i < run_length; i++) {
+        run[i] = (uint64_t)rand();
+    }
+
+    uint64_t checksum = 0;
+    auto c_start = high_resolution_clock::now();
+    for (uint32_t i = 0; i < total; i += run_length) {
+        push_run(stk_p, run.data(), run_length);
+        run[i % run_length] ^= u64_stk_get_top(stk_p);
+        pop_run(stk_p, run.data(), run_length);
+        checksum += run[0];
+    }
+    auto c_end = high_resolution_clock::now();
+
+    u64_stk_destroy(stk_p);
+
+    if (checksum == 42) {
+        std::cout << "";
+    }
+
+    return duration_cast<nanoseconds>(c_end - c_start).count();
+}
+
+static void scalar_push_run(struct u64_stk *stk_p, const uint64_t *values, const uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        u64_stk_push(stk_p, values[i]);
+    }
+}
+
+static void scalar_pop_run(struct u64_stk *stk_p, uint64_t *values, const uint32_t n)
+{
+    for (uint32_t i = n; i > 0; i--) {
+        values[i - 1] = u64_stk_pop(stk_p);
+    }
+}
+
+int main(void)
+{
+    srand((unsigned)time(NULL));
+
+    const uint32_t total = 100000000;
+
+    for (uint32_t i = 1; i <= 1024; i *= 4) {
+        /* keep the compiler from specializing the copies for the known run lengths */
+        volatile uint32_t opaque_run_length = i;
+        const uint32_t run_length = opaque_run_length;
+
+        const int64_t scalar_ns = benchmark(
+            total, run_length, [](struct u64_stk *stk_p, const uint64_t *values,
+                                  const uint32_t n) { scalar_push_run(stk_p, values, n); },
+            [](struct u64_stk *stk_p, uint64_t *values, const uint32_t n) { scalar_pop_run(stk_p, values, n); });
+        const int64_t bulk_ns = benchmark(
+            total, run_length,
+            [](struct u64_stk *stk_p, const uint64_t *values, const uint32_t n) { u64_stk_push_n(stk_p, values, n); },
+            [](struct u64_stk *stk_p, uint64_t *values, const uint32_t n) { u64_stk_pop_n(stk_p, values, n); });
+
+        std::cout << "time elapsed per element for " << total << " elements (push + pop, runs of " << run_length
+                  << "):" << std::endl;
+        std::cout << " push / pop:     " << (double)scalar_ns / total << " ns" << std::endl;
+        std::cout << " push_n / pop_n: " << (double)bulk_ns / total << " ns" << std::endl;
+    }
+
+    return 0;
+}
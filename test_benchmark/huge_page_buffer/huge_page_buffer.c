@@ -0,0 +1,105 @@
+#include "arena.h"
+#include "huge_page_buffer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BUF_LEN     ((size_t)1024 * 1024 * 1024)
+#define NODE_COUNT  (BUF_LEN / sizeof(struct node) - 1024)
+#define CHASE_COUNT (1 << 24)
+
+/* random-access workload: chasing pointers through a random cycle of nodes allocated from an arena */
+
+struct node {
+    struct node *next_ptr;
+    uint64_t value;
+    unsigned char payload[48];
+};
+
+static uint64_t xorshift64(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+static double benchmark(unsigned char *buf, const size_t len, const uint32_t *order)
+{
+    struct arena arena;
+    arena_init(&arena, len, buf);
+
+    struct node *nodes = arena_allocate_uninit(&arena, NODE_COUNT * sizeof(struct node));
+    if (!nodes) {
+        return -1.0;
+    }
+    for (size_t i = 0; i < NODE_COUNT; i++) {
+        nodes[order[i]].next_ptr = &nodes[order[(i + 1) % NODE_COUNT]];
+        nodes[order[i]].value = i;
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    uint64_t checksum = 0;
+    struct node *node = &nodes[order[0]];
+    for (uint32_t i = 0; i < CHASE_COUNT; i++) {
+        checksum += node->value;
+        node = node->next_ptr;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (checksum == 42) {
+        printf(" ");
+    }
+
+    return (double)(end.tv_sec - start.tv_sec) * 1e+3 + (double)(end.tv_nsec - start.tv_nsec) / 1e+6;
+}
+
+int main(void)
+{
+    uint32_t *order = malloc(NODE_COUNT * sizeof(uint32_t));
+    if (!order) {
+        return 1;
+    }
+    for (uint32_t i = 0; i < NODE_COUNT; i++) {
+        order[i] = i;
+    }
+    uint64_t state = 0x9e3779b97f4a7c15;
+    for (size_t i = NODE_COUNT - 1; i > 0; i--) {
+        const size_t j = xorshift64(&state) % (i + 1);
+        const uint32_t tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+
+    unsigned char *malloc_buf = malloc(BUF_LEN);
+    if (!malloc_buf) {
+        return 1;
+    }
+    const double malloc_ms = benchmark(malloc_buf, BUF_LEN, order);
+    free(malloc_buf);
+
+    struct huge_page_buffer hpb;
+    if (!huge_page_buffer_create(&hpb, BUF_LEN, true)) {
+        return 1;
+    }
+    const double hpb_ms = benchmark(hpb.ptr, hpb.len, order);
+
+    const char *kind_names[] = {"explicit", "transparent", "normal", "malloc"};
+
+    printf("time elapsed for %d dependent random accesses over %zu MiB of arena-allocated nodes:\n", CHASE_COUNT,
+           BUF_LEN / (1024 * 1024));
+    char hpb_label[64];
+    snprintf(hpb_label, sizeof(hpb_label), "huge_page_buffer.h (%s pages):", kind_names[hpb.kind]);
+
+    printf(" %-40s %.1f ms\n", "malloc() buffer:", malloc_ms);
+    printf(" %-40s %.1f ms\n", hpb_label, hpb_ms);
+
+    huge_page_buffer_destroy(&hpb);
+    free(order);
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include "lfstack.h"
+
+#define NAME       ptr_stk
+#define VALUE_TYPE void *
+#include "fstack.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+#define NODE_COUNT      1024
+#define TOTAL_POP_COUNT (1 << 23)
+
+/* a free-list shared by all threads, where each thread takes a buffer and gives it back */
+
+struct mutex_stack {
+    pthread_mutex_t mutex;
+    struct ptr_stk *stk_p;
+};
+
+struct thread_arg {
+    void *stack_p;
+    uint32_t iterations;
+    uint64_t checksum;
+};
+
+static void *lfstack_worker(void *arg_)
+{
+    struct thread_arg *arg = arg_;
+    struct lfstack *stack_p = arg->stack_p;
+
+    for (uint32_t i = 0; i < arg->iterations; i++) {
+        struct lfstack_node *node = lfstack_pop(stack_p);
+        if (!node) {
+            continue;
+        }
+        arg->checksum += (uintptr_t)node;
+        lfstack_push(stack_p, node);
+    }
+    return NULL;
+}
+
+static void *mutex_stack_worker(void *arg_)
+{
+    struct thread_arg *arg = arg_;
+    struct mutex_stack *stack_p = arg->stack_p;
+
+    for (uint32_t i = 0; i < arg->iterations; i++) {
+        pthread_mutex_lock(&stack_p->mutex);
+        void *node = ptr_stk_is_empty(stack_p->stk_p) ? NULL : ptr_stk_pop(stack_p->stk_p);
+        pthread_mutex_unlock(&stack_p->mutex);
+        if (!node) {
+            continue;
+        }
+        arg->checksum += (uintptr_t)node;
+        pthread_mutex_lock(&stack_p->mutex);
+        ptr_stk_push(stack_p->stk_p, node);
+        pthread_mutex_unlock(&stack_p->mutex);
+    }
+    return NULL;
+}
+
+static double benchmark(void *(*worker)(void *), void *stack_p, const uint32_t thread_count)
+{
+    pthread_t threads[64];
+    struct thread_arg args[64];
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (uint32_t i = 0; i < thread_count; i++) {
+        args[i] = (struct thread_arg){.stack_p = stack_p, .iterations = TOTAL_POP_COUNT / thread_count, .checksum = 0};
+        pthread_create(&threads[i], NULL, worker, &args[i]);
+    }
+    uint64_t checksum = 0;
+    for (uint32_t i = 0; i < thread_count; i++) {
+        pthread_join(threads[i], NULL);
+        checksum += args[i].checksum;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (checksum == 42) {
+        printf(" ");
+    }
+
+    return (double)(end.tv_sec - start.tv_sec) * 1e+3 + (double)(end.tv_nsec - start.tv_nsec) / 1e+6;
+}
+
+int main(void)
+{
+    static struct lfstack_node nodes[NODE_COUNT];
+
+    struct lfstack lfstack;
+    lfstack_init(&lfstack);
+
+    struct mutex_stack mutex_stack;
+    pthread_mutex_init(&mutex_stack.mutex, NULL);
+    mutex_stack.stk_p = ptr_stk_create(NODE_COUNT);
+
+    for (uint32_t i = 0; i < NODE_COUNT; i++) {
+        lfstack_push(&lfstack, &nodes[i]);
+        ptr_stk_push(mutex_stack.stk_p, &nodes[i]);
+    }
+
+    for (uint32_t thread_count = 1; thread_count <= 64; thread_count *= 2) {
+        const double lfstack_ms = benchmark(lfstack_worker, &lfstack, thread_count);
+        const double mutex_ms = benchmark(mutex_stack_worker, &mutex_stack, thread_count);
+
+        printf("time elapsed for %d pop + push pairs with %u threads:\n", TOTAL_POP_COUNT, thread_count);
+        printf(" lfstack.h:        %.1f ms\n", lfstack_ms);
+        printf(" mutex + fstack.h: %.1f ms\n", mutex_ms);
+    }
+
+    ptr_stk_destroy(mutex_stack.stk_p);
+    pthread_mutex_destroy(&mutex_stack.mutex);
+
+    return 0;
+}
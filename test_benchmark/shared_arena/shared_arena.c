@@ -0,0 +1,129 @@
+#include "shared_arena.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BUF_LEN                ((size_t)512 * 1024 * 1024)
+#define TOTAL_ALLOCATION_COUNT (1 << 24)
+#define ALLOCATION_SIZE        24
+
+/* parser-like workload: many small allocations from one arena shared by all threads */
+
+struct mutex_arena {
+    pthread_mutex_t mutex;
+    struct arena arena;
+};
+
+struct thread_arg {
+    void *arena_p;
+    uint32_t iterations;
+    uint64_t checksum;
+};
+
+static void *mutex_arena_worker(void *arg_)
+{
+    struct thread_arg *arg = arg_;
+    struct mutex_arena *arena_p = arg->arena_p;
+
+    for (uint32_t i = 0; i < arg->iterations; i++) {
+        pthread_mutex_lock(&arena_p->mutex);
+        unsigned char *ptr = arena_allocate_uninit(&arena_p->arena, ALLOCATION_SIZE);
+        pthread_mutex_unlock(&arena_p->mutex);
+        ptr[0] = (unsigned char)i;
+        arg->checksum += (uintptr_t)ptr;
+    }
+    return NULL;
+}
+
+static void *shared_arena_worker(void *arg_)
+{
+    struct thread_arg *arg = arg_;
+    struct shared_arena *arena_p = arg->arena_p;
+
+    for (uint32_t i = 0; i < arg->iterations; i++) {
+        unsigned char *ptr = shared_arena_allocate_uninit(arena_p, ALLOCATION_SIZE);
+        ptr[0] = (unsigned char)i;
+        arg->checksum += (uintptr_t)ptr;
+    }
+    return NULL;
+}
+
+static void *local_arena_worker(void *arg_)
+{
+    struct thread_arg *arg = arg_;
+    struct shared_arena *arena_p = arg->arena_p;
+    struct arena local = {0};
+
+    for (uint32_t i = 0; i < arg->iterations; i++) {
+        unsigned char *ptr = shared_arena_local_allocate(arena_p, &local, ALLOCATION_SIZE);
+        ptr[0] = (unsigned char)i;
+        arg->checksum += (uintptr_t)ptr;
+    }
+    return NULL;
+}
+
+static double benchmark(void *(*worker)(void *), void *arena_p, const uint32_t thread_count)
+{
+    pthread_t threads[64];
+    struct thread_arg args[64];
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (uint32_t i = 0; i < thread_count; i++) {
+        args[i] = (struct thread_arg){
+            .arena_p = arena_p, .iterations = TOTAL_ALLOCATION_COUNT / thread_count, .checksum = 0};
+        pthread_create(&threads[i], NULL, worker, &args[i]);
+    }
+    uint64_t checksum = 0;
+    for (uint32_t i = 0; i < thread_count; i++) {
+        pthread_join(threads[i], NULL);
+        checksum += args[i].checksum;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    if (checksum == 42) {
+        printf(" ");
+    }
+
+    return (double)(end.tv_sec - start.tv_sec) * 1e+3 + (double)(end.tv_nsec - start.tv_nsec) / 1e+6;
+}
+
+int main(void)
+{
+    unsigned char *buf = malloc(BUF_LEN);
+    if (!buf) {
+        return 1;
+    }
+    memset(buf, 0, BUF_LEN);
+
+    struct mutex_arena mutex_arena;
+    pthread_mutex_init(&mutex_arena.mutex, NULL);
+
+    struct shared_arena shared_arena;
+
+    for (uint32_t thread_count = 1; thread_count <= 64; thread_count *= 2) {
+        arena_init(&mutex_arena.arena, BUF_LEN, buf);
+        const double mutex_ms = benchmark(mutex_arena_worker, &mutex_arena, thread_count);
+
+        shared_arena_init(&shared_arena, BUF_LEN, buf);
+        const double shared_ms = benchmark(shared_arena_worker, &shared_arena, thread_count);
+
+        shared_arena_init(&shared_arena, BUF_LEN, buf);
+        const double local_ms = benchmark(local_arena_worker, &shared_arena, thread_count);
+
+        printf("time elapsed for %d allocations of %d bytes with %u threads:\n", TOTAL_ALLOCATION_COUNT,
+               ALLOCATION_SIZE, thread_count);
+        printf(" mutex + arena.h:                    %.1f ms\n", mutex_ms);
+        printf(" shared_arena.h (fetch_add):         %.1f ms\n", shared_ms);
+        printf(" shared_arena.h (local sub-arenas):  %.1f ms\n", local_ms);
+    }
+
+    pthread_mutex_destroy(&mutex_arena.mutex);
+    free(buf);
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+extern "C" {
+
+#ifdef __cplusplus
+#ifdef __GNUC__
+#define restrict __restrict__
+#else
+#define restrict
+#endif
+#endif
+
+#include "sliding_window.h"
+}
+
+struct result {
+    double mean;
+    double checksum;
+};
+
+// sum, mean, variance, min and max per sample
+static result benchmark_sliding_window(const std::vector<float> &samples, const uint32_t window_size)
+{
+    struct sliding_window *w = sliding_window_create(window_size);
+    double checksum = 0.;
+    for (const float x : samples) {
+        sliding_window_push(w, x);
+        checksum += sliding_window_mean(w) + sliding_window_variance(w) + sliding_window_min(w) + sliding_window_max(w);
+    }
+    const double mean = sliding_window_mean(w);
+    sliding_window_destroy(w);
+    return {mean, checksum};
+}
+
+// mean only, updated with float multiply / divide per sample (as the example did previously)
+static result benchmark_float_recurrence(const std::vector<float> &samples, const uint32_t window_size)
+{
+    float avg = 0.f;
+    double checksum = 0.;
+    for (size_t i = 0; i < samples.size(); i++) {
+        if (i < window_size) {
+            avg = (avg * (float)i + samples[i]) / (float)(i + 1);
+        }
+        else {
+            avg = (avg * (float)window_size - samples[i - window_size] + samples[i]) / (float)window_size;
+        }
+        checksum += avg;
+    }
+    return {avg, checksum};
+}
+
+int main(void)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::high_resolution_clock;
+    using std::chrono::microseconds;
+
+    const size_t N = 10000000;
+    const uint32_t window_size = 1000;
+
+    std::vector<float> samples(N);
+    srand(42);
+    for (size_t i = 0; i < N; i++) {
+        samples[i] = 1000.f + (float)(rand() % 100000) / 100.f;
+    }
+
+    long double exact_sum = 0.;
+    for (size_t i = N - window_size; i < N; i++) {
+        exact_sum += samples[i];
+    }
+    const double exact_mean = (double)(exact_sum / window_size);
+
+    auto c_start1 = high_resolution_clock::now();
+    const result r1 = benchmark_sliding_window(samples, window_size);
+    auto c_end1 = high_resolution_clock::now();
+
+    auto c_start2 = high_resolution_clock::now();
+    const result r2 = benchmark_float_recurrence(samples, window_size);
+    auto c_end2 = high_resolution_clock::now();
+
+    std::cout << "time elapsed for " << N << " samples (window size " << window_size << "):" << std::endl;
+    std::cout << " sliding window (sum/mean/variance/min/max): "
+              << duration_cast<microseconds>(c_end1 - c_start1).count() << " μs, final mean error: "
+              << std::fabs(r1.mean - exact_mean) << " (checksum " << r1.checksum << ")" << std::endl;
+    std::cout << " float recurrence (mean only): " << duration_cast<microseconds>(c_end2 - c_start2).count()
+              << " μs, final mean error: " << std::fabs(r2.mean - exact_mean) << " (checksum " << r2.checksum << ")"
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,149 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+extern "C" {
+
+#ifdef __cplusplus
+#ifdef __GNUC__
+#define restrict __restrict__
+#define typeof   __typeof__
+#else
+#define restrict
+#endif
+#endif
+
+#include "timing_wheel.h"
+
+struct timeout_ref {
+    uint32_t id;
+    uint32_t gen;
+};
+
+#define NAME                   timeout_pque
+#define VALUE_TYPE             struct timeout_ref
+#define PRIORITY_TYPE          uint64_t
+#define PRIORITY_IS_LESS(a, b) ((a) > (b))
+#include "fpqueue.h"
+}
+
+/* connection timeout workload: N connections with a timeout each. every op
+   is activity on a random connection, which cancels and reschedules its
+   timeout. the clock advances one tick every 100 ops, and expired
+   connections are rescheduled right away */
+
+static const uint64_t timeout = 30000;
+static const size_t ops_per_tick = 100;
+
+struct connection {
+    uint32_t gen;
+    struct timing_wheel_timer timer;
+};
+
+static int64_t benchmark_timing_wheel(const std::vector<uint32_t> &ids, const size_t N, uint64_t &expired_count)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::high_resolution_clock;
+    using std::chrono::microseconds;
+
+    std::vector<struct connection> conns(N);
+    struct timing_wheel *wheel = (struct timing_wheel *)malloc(sizeof(struct timing_wheel));
+    struct list_node expired;
+
+    timing_wheel_init(wheel, 0);
+    list_node_init(&expired);
+
+    auto c_start = high_resolution_clock::now();
+    for (size_t i = 0; i < N; i++) {
+        timing_wheel_timer_init(&conns[i].timer);
+        timing_wheel_schedule(wheel, &conns[i].timer, i % timeout + 1);
+    }
+    uint64_t now = 0;
+    for (size_t i = 0; i < ids.size(); i++) {
+        struct connection *conn = &conns[ids[i] % N];
+        timing_wheel_cancel(wheel, &conn->timer);
+        timing_wheel_schedule(wheel, &conn->timer, now + timeout);
+
+        if ((i + 1) % ops_per_tick == 0) {
+            expired_count += timing_wheel_advance(wheel, ++now, &expired);
+            while (expired.next_ptr != &expired) {
+                struct list_node *node = list_node_remove(expired.next_ptr);
+                struct timing_wheel_timer *timer = list_node_entry(node, struct timing_wheel_timer, node);
+                timing_wheel_schedule(wheel, timer, now + timeout);
+            }
+        }
+    }
+    auto c_end = high_resolution_clock::now();
+
+    free(wheel);
+
+    return duration_cast<microseconds>(c_end - c_start).count();
+}
+
+static int64_t benchmark_fpqueue(const std::vector<uint32_t> &ids, const size_t N, uint64_t &expired_count)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::high_resolution_clock;
+    using std::chrono::microseconds;
+
+    /* cancelled timeouts stay in the queue, and are skipped when popped by checking the generation */
+    std::vector<struct connection> conns(N);
+    struct timeout_pque *pque_p = timeout_pque_create((uint32_t)(N + ids.size()));
+
+    auto c_start = high_resolution_clock::now();
+    for (size_t i = 0; i < N; i++) {
+        conns[i].gen = 0;
+        timeout_pque_push(pque_p, (struct timeout_ref){(uint32_t)i, 0}, i % timeout + 1);
+    }
+    uint64_t now = 0;
+    for (size_t i = 0; i < ids.size(); i++) {
+        const uint32_t id = (uint32_t)(ids[i] % N);
+        conns[id].gen++;
+        timeout_pque_push(pque_p, (struct timeout_ref){id, conns[id].gen}, now + timeout);
+
+        if ((i + 1) % ops_per_tick == 0) {
+            now++;
+            while (!timeout_pque_is_empty(pque_p) && pque_p->elements[0].priority <= now) {
+                const struct timeout_ref ref = timeout_pque_pop_max(pque_p);
+                if (ref.gen != conns[ref.id].gen) {
+                    continue;
+                }
+                expired_count++;
+                conns[ref.id].gen++;
+                timeout_pque_push(pque_p, (struct timeout_ref){ref.id, conns[ref.id].gen}, now + timeout);
+            }
+        }
+    }
+    auto c_end = high_resolution_clock::now();
+
+    timeout_pque_destroy(pque_p);
+
+    return duration_cast<microseconds>(c_end - c_start).count();
+}
+
+int main(void)
+{
+    srand(time(NULL));
+
+    const size_t ops = 10000000;
+
+    std::vector<uint32_t> ids(ops);
+    for (size_t i = 0; i < ops; i++) {
+        ids[i] = (uint32_t)rand();
+    }
+
+    for (size_t N = 1000; N <= 1000000; N *= 10) {
+        uint64_t wheel_expired = 0, pque_expired = 0;
+        const int64_t wheel_us = benchmark_timing_wheel(ids, N, wheel_expired);
+        const int64_t pque_us = benchmark_fpqueue(ids, N, pque_expired);
+
+        std::cout << "time elapsed for " << ops << " (cancel, schedule) with " << N << " connections:" << std::endl;
+        std::cout << " timing_wheel.h: " << wheel_us << " μs (" << wheel_expired << " expired)" << std::endl;
+        std::cout << " fpqueue.h:      " << pque_us << " μs (" << pque_expired << " expired)" << std::endl;
+    }
+
+    return 0;
+}
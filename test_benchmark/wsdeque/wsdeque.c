@@ -0,0 +1,135 @@
+#define NAME       u64_wsdeque
+#define VALUE_TYPE uint64_t
+#include "wsdeque.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+#define FIB_N            38
+#define FIB_CUTOFF       16
+#define MAX_THREAD_COUNT 8
+
+/* fork-join fib(n) on a work-stealing scheduler. a task is just n, and tasks below the cutoff are run serially */
+
+struct scheduler {
+    uint32_t thread_count;
+    _Atomic uint64_t pending_count;
+    _Atomic uint64_t result;
+    struct u64_wsdeque *deques[MAX_THREAD_COUNT];
+};
+
+struct worker_arg {
+    struct scheduler *sched_p;
+    uint32_t index;
+    uint64_t steal_count;
+};
+
+static uint64_t fib(const uint64_t n)
+{
+    return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+
+static inline uint32_t xorshift32(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static void *worker(void *arg_)
+{
+    struct worker_arg *arg = arg_;
+    struct scheduler *sched_p = arg->sched_p;
+    struct u64_wsdeque *own_p = sched_p->deques[arg->index];
+
+    uint32_t state = arg->index + 1;
+    uint64_t sum = 0;
+
+    while (atomic_load_explicit(&sched_p->pending_count, memory_order_acquire) > 0) {
+        uint64_t n;
+
+        if (!u64_wsdeque_pop(own_p, &n)) {
+            const uint32_t victim = xorshift32(&state) % sched_p->thread_count;
+
+            if (victim == arg->index || !u64_wsdeque_steal(sched_p->deques[victim], &n)) {
+                continue;
+            }
+            arg->steal_count++;
+        }
+
+        if (n < FIB_CUTOFF) {
+            sum += fib(n);
+            atomic_fetch_sub_explicit(&sched_p->pending_count, 1, memory_order_release);
+        }
+        else {
+            /* two tasks forked and one joined */
+            atomic_fetch_add_explicit(&sched_p->pending_count, 1, memory_order_relaxed);
+            u64_wsdeque_push(own_p, n - 2);
+            u64_wsdeque_push(own_p, n - 1);
+        }
+    }
+
+    atomic_fetch_add(&sched_p->result, sum);
+
+    return NULL;
+}
+
+static double elapsed_ms(const struct timespec start, const struct timespec end)
+{
+    return (double)(end.tv_sec - start.tv_sec) * 1e+3 + (double)(end.tv_nsec - start.tv_nsec) / 1e+6;
+}
+
+int main(void)
+{
+    struct timespec start, end;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    const uint64_t expected = fib(FIB_N);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    printf("time elapsed for fib(%d):\n", FIB_N);
+    printf(" serial:              %.1f ms\n", elapsed_ms(start, end));
+
+    for (uint32_t thread_count = 1; thread_count <= MAX_THREAD_COUNT; thread_count *= 2) {
+        struct scheduler sched = {.thread_count = thread_count};
+        atomic_init(&sched.pending_count, 1);
+        atomic_init(&sched.result, 0);
+
+        for (uint32_t i = 0; i < thread_count; i++) {
+            sched.deques[i] = u64_wsdeque_create(64);
+        }
+        u64_wsdeque_push(sched.deques[0], FIB_N);
+
+        pthread_t threads[MAX_THREAD_COUNT];
+        struct worker_arg args[MAX_THREAD_COUNT];
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (uint32_t i = 0; i < thread_count; i++) {
+            args[i] = (struct worker_arg){.sched_p = &sched, .index = i, .steal_count = 0};
+            pthread_create(&threads[i], NULL, worker, &args[i]);
+        }
+        uint64_t steal_count = 0;
+        for (uint32_t i = 0; i < thread_count; i++) {
+            pthread_join(threads[i], NULL);
+            steal_count += args[i].steal_count;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        if (atomic_load(&sched.result) != expected) {
+            printf("wrong result!\n");
+            return 1;
+        }
+
+        printf(" wsdeque.h, %u threads: %.1f ms (%lu steals)\n", thread_count, elapsed_ms(start, end),
+               (unsigned long)steal_count);
+
+        for (uint32_t i = 0; i < thread_count; i++) {
+            u64_wsdeque_destroy(sched.deques[i]);
+        }
+    }
+
+    return 0;
+}
@@ -3,19 +3,23 @@
     Neither is the temporary arena functions, since the functions contain no branches and are simple.
 
     Mutating operation types:
-    - init
+    - init / init_virtual
+    - deinit_virtual
     - deallocate_all
-    - allocate_aligned / allocate
-    - reallocate_aligned / reallocate
+    - allocate_aligned / allocate (+ _uninit)
+    - reallocate_aligned / reallocate (+ _uninit)
 
     Branches:
     - allocate_aligned()
-        | !has_space_left -> NULL
+        | !has_space_left && (!fits_reserve || !commit) -> NULL
+        | !has_space_left -> (commit more of the reserved memory and retry)
         | otherwise -> (non-NULL pointer to chunk of initialized memory with correct alignment)
     - reallocate_aligned()
         | new_size == 0 || old_ptr == NULL || new_size || !inside_arena_buf -> NULL
-        | has_optimized_w_prev_buf -> (same pointer, but interally shrinks/grows the memory chunk)
+        | has_optimized_w_prev_buf -> (same pointer, but interally shrinks/grows the memory chunk, committing more
+                                       of the reserved memory if needed)
         | otherwise -> (new chunk of memory with previous buffer copied into with correct alignment)
+        | zero -> (grown part is zeroed out in both cases above)
 */
 
 #include "arena.h"
@@ -118,6 +122,19 @@ int main(void)
         assert(memcmp(ptr, "zy", 2) == 0);
         assert(!arena_allocate_aligned(&a, 1, 1));
     }
+    // grow the previous chunk past the end of a fixed buffer:
+    {
+        struct arena a;
+        unsigned char buf[16];
+        arena_init(&a, sizeof(buf), buf);
+
+        (void)(arena_allocate_aligned(&a, 1, 1));
+        char *ptr = arena_allocate_aligned(&a, 1, 2);
+        assert(!arena_reallocate_aligned(&a, ptr, 1, 2, sizeof(buf)));
+        assert(!arena_reallocate_aligned(&a, ptr, 1, 2, SIZE_MAX));
+        assert(arena_reallocate_aligned(&a, ptr, 1, 2, sizeof(buf) - 1) == ptr);
+        assert(!arena_allocate_aligned(&a, 1, 1));
+    }
     // initialize with unaligned buffer:
     {
         struct arena a;
@@ -164,4 +181,73 @@ int main(void)
 
         assert(!arena_allocate_aligned(&a, 1, 1));
     }
+    // growable arena with reserved virtual memory:
+    {
+        struct arena a;
+        assert(!arena_init_virtual(&a, 0));
+        assert(arena_init_virtual(&a, (size_t)1 << 30));
+
+        const size_t chunk_size = ARENA_MIN_COMMIT_LEN + 1;
+        unsigned char *first = arena_allocate(&a, chunk_size);
+        assert(first != NULL);
+        memset(first, 'a', chunk_size);
+
+        unsigned char *last = NULL;
+        for (size_t i = 0; i < 256; i++) {
+            last = arena_allocate(&a, chunk_size);
+            assert(last != NULL);
+            memset(last, 'b', chunk_size);
+        }
+        for (size_t i = 0; i < chunk_size; i++) {
+            assert(first[i] == 'a');
+        }
+
+        unsigned char *grown = arena_reallocate(&a, last, chunk_size, 64 * chunk_size);
+        assert(grown == last);
+        assert(grown[chunk_size - 1] == 'b' && grown[64 * chunk_size - 1] == 0);
+
+        assert(!arena_allocate(&a, (size_t)1 << 30));
+        assert(!arena_allocate(&a, SIZE_MAX));
+
+        arena_deallocate_all(&a);
+        assert(arena_allocate(&a, 1) == first);
+
+        arena_deinit_virtual(&a);
+    }
+    // zeroed and uninitialized allocations on a dirty arena:
+    {
+        struct arena a;
+        alignas(max_align_t) unsigned char buf[64];
+        arena_init(&a, sizeof(buf), buf);
+        memset(buf, 0xff, sizeof(buf));
+
+        unsigned char *p = arena_allocate_uninit(&a, 8);
+        assert(p == &buf[0] && p[0] == 0xff);
+
+        p = arena_reallocate_uninit(&a, p, 8, 16);
+        assert(p == &buf[0] && p[15] == 0xff);
+
+        p = arena_reallocate(&a, p, 16, 24);
+        assert(p == &buf[0] && p[15] == 0xff);
+        for (size_t i = 16; i < 24; i++) {
+            assert(p[i] == 0);
+        }
+        assert(buf[24] == 0xff);
+
+        unsigned char *q = arena_allocate_aligned_uninit(&a, 1, 4);
+        assert(q == &buf[24] && q[0] == 0xff);
+
+        p = arena_reallocate(&a, p, 24, 32);
+        assert(p == &buf[32]);
+        for (size_t i = 24; i < 32; i++) {
+            assert(p[i] == 0);
+        }
+
+        arena_deallocate_all(&a);
+        p = arena_allocate(&a, 8);
+        assert(p == &buf[0]);
+        for (size_t i = 0; i < 8; i++) {
+            assert(p[i] == 0);
+        }
+    }
 }
@@ -0,0 +1,64 @@
+/*
+    Tests the arena usage statistics, which are only compiled in with ARENA_STATS. The arena itself is tested in
+    tests/arena with the default configuration.
+
+    Mutating operation types:
+    - reset_stats
+
+    Non-mutating operation types:
+    - get_stats
+
+    Counted events:
+    - allocate_aligned / allocate
+        | NULL -> (failed allocation)
+        | otherwise -> (allocation, padding bytes, high water mark)
+    - reallocate_aligned / reallocate
+        | NULL -> (failed allocation)
+        | has_optimized_w_prev_buf -> (high water mark)
+        | otherwise -> (allocation, padding bytes, high water mark)
+    - deallocate_all / temp_arena_state_restore -> (high water mark is kept)
+*/
+
+#define ARENA_STATS
+#include "arena.h"
+
+int main(void)
+{
+    // usage statistics:
+    {
+        struct arena a;
+        alignas(max_align_t) unsigned char buf[64];
+        arena_init(&a, sizeof(buf), buf);
+
+        struct arena_stats stats = arena_get_stats(&a);
+        assert(stats.high_water_mark == 0 && stats.allocation_count == 0);
+        assert(stats.padding_bytes == 0 && stats.failed_allocation_count == 0);
+
+        unsigned char *p = arena_allocate_aligned(&a, 1, 3);
+        (void)(arena_allocate_aligned(&a, 8, 8));
+        stats = arena_get_stats(&a);
+        assert(stats.high_water_mark == 16 && stats.allocation_count == 2 && stats.padding_bytes == 5);
+
+        struct temp_arena_state state = temp_arena_state_save(&a);
+        p = arena_reallocate_aligned(&a, p, 1, 3, 4);
+        assert(p == &buf[16]);
+        p = arena_reallocate_aligned(&a, p, 1, 4, 40);
+        assert(p == &buf[16]);
+        stats = arena_get_stats(&a);
+        assert(stats.high_water_mark == 56 && stats.allocation_count == 3 && stats.padding_bytes == 5);
+
+        assert(!arena_allocate(&a, 16));
+        assert(!arena_reallocate(&a, p, 40, 64));
+        assert(arena_get_stats(&a).failed_allocation_count == 2);
+
+        temp_arena_state_restore(state);
+        arena_deallocate_all(&a);
+        assert(arena_get_stats(&a).high_water_mark == 56);
+
+        (void)(arena_allocate(&a, 1));
+        arena_reset_stats(&a);
+        stats = arena_get_stats(&a);
+        assert(stats.high_water_mark == 1 && stats.allocation_count == 0);
+        assert(stats.padding_bytes == 0 && stats.failed_allocation_count == 0);
+    }
+}
@@ -0,0 +1,251 @@
+/*
+    Test cases (N):
+    - N := 0
+    - N := 1
+    - N := 2
+    - N := 10
+    - N := 1e+6
+
+    Non-mutating operation types / properties:
+    - .count
+    - .capacity
+    - is_empty
+    - is_full
+    - get_front
+    - get_back
+    - at + deque_for_each + deque_for_each_reverse
+
+    Mutating operation types:
+    - push_back / enqueue
+    - push_front
+    - pop_front / dequeue
+    - pop_back
+    - reserve (this is indirectly tested for with pushes on a full deque)
+    - clear
+
+    Memory operations [to also be tested with sanitizers]:
+    - create
+    - destroy
+    - copy
+*/
+
+#define NAME       i64_deque
+#define VALUE_TYPE int64_t
+#include "deque.h"
+
+static inline bool check_count_invariance(const struct i64_deque *deq_p, const size_t push_op_count,
+                                          const size_t pop_op_count)
+{
+    return deq_p->count == (push_op_count - pop_op_count);
+}
+
+static inline bool check_capacity_invariance(const struct i64_deque *deq_p, const size_t suggested_capacity)
+{
+    return deq_p->capacity >= suggested_capacity && is_pow2(deq_p->capacity);
+}
+
+static inline bool check_front_back(const struct i64_deque *deq_p, const int64_t front_value,
+                                    const int64_t back_value)
+{
+    return i64_deque_get_front(deq_p) == front_value && i64_deque_get_back(deq_p) == back_value;
+}
+
+static inline bool check_ordered_values(const struct i64_deque *deq_p, const size_t n,
+                                        const int64_t expected_value[n])
+{
+    assert(n != 0);
+
+    bool res = deq_p->count == n;
+    for (size_t i = 0; i < n; i++) {
+        res &= i64_deque_at(deq_p, (uint32_t)i) == expected_value[i];
+    }
+    {
+        size_t index = 0;
+        int64_t value;
+
+        uint32_t tempi;
+        deque_for_each(deq_p, tempi, value)
+        {
+            res &= value == expected_value[index++];
+        }
+        assert(index == n);
+    }
+    {
+        size_t index = n;
+        int64_t value;
+
+        uint32_t tempi;
+        deque_for_each_reverse(deq_p, tempi, value)
+        {
+            res &= value == expected_value[--index];
+        }
+        assert(index == 0);
+    }
+    return res;
+}
+
+static inline bool copy_values_and_check_ordered_values(const struct i64_deque *deq_p, const size_t n,
+                                                        const int64_t expected_value[n])
+{
+    assert(n != 0);
+
+    struct i64_deque *deq_copy_p = i64_deque_create(1);
+    if (!deq_copy_p) {
+        return false;
+    }
+    if (!i64_deque_copy(deq_copy_p, deq_p)) {
+        i64_deque_destroy(deq_copy_p);
+        return false;
+    }
+    const bool res = check_ordered_values(deq_copy_p, n, expected_value);
+    i64_deque_destroy(deq_copy_p);
+    return res;
+}
+
+int main(void)
+{
+    // N = 0
+    {
+        struct i64_deque *deq_p = i64_deque_create(0);
+        if (deq_p) {
+            assert(false);
+        }
+    }
+    // N = 1
+    {
+        struct i64_deque *deq_p = i64_deque_create(1);
+        if (!deq_p) {
+            assert(false);
+        }
+
+        assert(check_count_invariance(deq_p, 0, 0));
+        assert(check_capacity_invariance(deq_p, 1));
+        assert(i64_deque_is_empty(deq_p));
+        assert(!i64_deque_is_full(deq_p));
+
+        i64_deque_destroy(deq_p);
+    }
+    // N = 1, push_back -> pop_back / push_front -> pop_front
+    {
+        struct i64_deque *deq_p = i64_deque_create(1);
+        if (!deq_p) {
+            assert(false);
+        }
+        assert(i64_deque_push_back(deq_p, 42));
+        assert(i64_deque_is_full(deq_p));
+        assert(check_front_back(deq_p, 42, 42));
+        assert(i64_deque_pop_back(deq_p) == 42);
+
+        assert(i64_deque_push_front(deq_p, 69));
+        assert(check_front_back(deq_p, 69, 69));
+        assert(i64_deque_pop_front(deq_p) == 69);
+
+        assert(check_count_invariance(deq_p, 2, 2));
+        assert(check_capacity_invariance(deq_p, 1));
+        assert(i64_deque_is_empty(deq_p));
+
+        i64_deque_destroy(deq_p);
+    }
+    // N = 2, push_front * 2 (grows from capacity 1)
+    {
+        struct i64_deque *deq_p = i64_deque_create(1);
+        if (!deq_p) {
+            assert(false);
+        }
+        assert(i64_deque_push_front(deq_p, 69));
+        assert(i64_deque_push_front(deq_p, 42));
+
+        assert(check_count_invariance(deq_p, 2, 0));
+        assert(check_capacity_invariance(deq_p, 2));
+        assert(check_front_back(deq_p, 42, 69));
+        assert(check_ordered_values(deq_p, 2, (int64_t[2]){42, 69}));
+        assert(copy_values_and_check_ordered_values(deq_p, 2, (int64_t[2]){42, 69}));
+
+        i64_deque_destroy(deq_p);
+    }
+    // N = 10, mixed pushes on both ends, with the ring wrapped before growing
+    {
+        struct i64_deque *deq_p = i64_deque_create(4);
+        if (!deq_p) {
+            assert(false);
+        }
+        assert(i64_deque_enqueue(deq_p, 425));
+        assert(i64_deque_enqueue(deq_p, 426));
+        assert(i64_deque_push_front(deq_p, 424));
+        assert(i64_deque_push_front(deq_p, 423));
+        assert(i64_deque_is_full(deq_p));
+
+        assert(i64_deque_push_back(deq_p, 427));
+        assert(i64_deque_push_front(deq_p, 422));
+        assert(i64_deque_push_back(deq_p, 428));
+        assert(i64_deque_push_front(deq_p, 421));
+        assert(i64_deque_push_back(deq_p, 429));
+        assert(i64_deque_push_back(deq_p, 430));
+
+        assert(check_count_invariance(deq_p, 10, 0));
+        assert(check_capacity_invariance(deq_p, 10));
+        assert(check_front_back(deq_p, 421, 430));
+        assert(check_ordered_values(deq_p, 10, (int64_t[10]){421, 422, 423, 424, 425, 426, 427, 428, 429, 430}));
+        assert(copy_values_and_check_ordered_values(deq_p, 10,
+                                                    (int64_t[10]){421, 422, 423, 424, 425, 426, 427, 428, 429, 430}));
+
+        assert(i64_deque_pop_front(deq_p) == 421);
+        assert(i64_deque_pop_back(deq_p) == 430);
+        assert(i64_deque_dequeue(deq_p) == 422);
+        assert(i64_deque_pop_back(deq_p) == 429);
+
+        assert(check_count_invariance(deq_p, 10, 4));
+        assert(check_front_back(deq_p, 423, 428));
+        assert(check_ordered_values(deq_p, 6, (int64_t[6]){423, 424, 425, 426, 427, 428}));
+
+        i64_deque_destroy(deq_p);
+    }
+    // N = 10, push_back * 10 -> clear() -> push_front * 5
+    {
+        struct i64_deque *deq_p = i64_deque_create(10);
+        if (!deq_p) {
+            assert(false);
+        }
+        for (size_t i = 0; i < 10; i++) {
+            assert(i64_deque_push_back(deq_p, 420 + (int)i));
+        }
+        i64_deque_clear(deq_p);
+
+        for (size_t i = 0; i < 5; i++) {
+            assert(i64_deque_push_front(deq_p, 435 - (int)i));
+        }
+
+        assert(check_count_invariance(deq_p, 15 - 10, 0));
+        assert(check_capacity_invariance(deq_p, 10));
+        assert(check_front_back(deq_p, 431, 435));
+        assert(check_ordered_values(deq_p, 5, (int64_t[5]){431, 432, 433, 434, 435}));
+        assert(copy_values_and_check_ordered_values(deq_p, 5, (int64_t[5]){431, 432, 433, 434, 435}));
+
+        i64_deque_destroy(deq_p);
+    }
+    // N = 1e+6, alternating push_front / push_back -> pop both ends
+    {
+        struct i64_deque *deq_p = i64_deque_create(1);
+        if (!deq_p) {
+            assert(false);
+        }
+        for (size_t i = 0; i < 1e+6 / 2; i++) {
+            assert(i64_deque_push_front(deq_p, -(int64_t)i - 1));
+            assert(i64_deque_push_back(deq_p, (int64_t)i));
+        }
+        assert(check_count_invariance(deq_p, 1e+6, 0));
+        assert(check_capacity_invariance(deq_p, 1e+6));
+        assert(check_front_back(deq_p, -(int64_t)(1e+6 / 2), (int64_t)(1e+6 / 2) - 1));
+
+        for (size_t i = 0; i < 1e+6; i++) {
+            assert(i64_deque_at(deq_p, (uint32_t)i) == (int64_t)i - (int64_t)(1e+6 / 2));
+        }
+        for (size_t i = 0; i < 1e+3; i++) {
+            assert(i64_deque_pop_front(deq_p) == (int64_t)i - (int64_t)(1e+6 / 2));
+            assert(i64_deque_pop_back(deq_p) == (int64_t)(1e+6 / 2) - 1 - (int64_t)i);
+        }
+        assert(check_count_invariance(deq_p, 1e+6, 2e+3));
+
+        i64_deque_destroy(deq_p);
+    }
+}
@@ -0,0 +1,218 @@
+/*
+    Test cases (N):
+    - N := 0
+    - N := 1
+    - N := 10
+    - N := 1e+6 (values passed between threads)
+
+    Non-mutating operation types / properties:
+    - .capacity
+    - count
+    - calc_sizeof (this is indirectly tested for with `create`)
+
+    Mutating operation types:
+    - try_enqueue
+    - try_dequeue
+    - enqueue_wait / enqueue
+    - dequeue_wait / dequeue
+
+    Branches:
+    - enqueue_wait() / dequeue_wait()
+        | not full / not empty -> (returns without blocking)
+        | full / empty until timeout -> false
+        | full / empty until other thread dequeues / enqueues -> true
+
+    Memory operations [to also be tested with sanitizers]:
+    - init (this is indirectly tested for with `create`)
+    - create
+    - destroy
+*/
+
+#define NAME       i64_bque
+#define VALUE_TYPE int64_t
+#include "fbqueue.h"
+
+#include <pthread.h>
+
+#define THREAD_COUNT (4U)
+#define VALUE_COUNT  (1000000U)
+
+struct thread_arg {
+    struct i64_bque *que_p;
+    uint32_t thread_index;
+    int64_t sum;
+};
+
+static void *producer(void *arg_)
+{
+    struct thread_arg *arg = arg_;
+
+    for (uint32_t i = arg->thread_index; i < VALUE_COUNT; i += THREAD_COUNT) {
+        i64_bque_enqueue(arg->que_p, (int64_t)i);
+        arg->sum += (int64_t)i;
+    }
+    return NULL;
+}
+
+static void *consumer(void *arg_)
+{
+    struct thread_arg *arg = arg_;
+
+    for (uint32_t i = arg->thread_index; i < VALUE_COUNT; i += THREAD_COUNT) {
+        arg->sum += i64_bque_dequeue(arg->que_p);
+    }
+    return NULL;
+}
+
+static void *delayed_dequeue(void *arg_)
+{
+    struct thread_arg *arg = arg_;
+
+    const struct timespec ts = {.tv_sec = 0, .tv_nsec = 10000000};
+    nanosleep(&ts, NULL);
+
+    int64_t value;
+    assert(i64_bque_try_dequeue(arg->que_p, &value));
+    arg->sum = value;
+    return NULL;
+}
+
+static void *delayed_enqueue(void *arg_)
+{
+    struct thread_arg *arg = arg_;
+
+    const struct timespec ts = {.tv_sec = 0, .tv_nsec = 10000000};
+    nanosleep(&ts, NULL);
+
+    assert(i64_bque_try_enqueue(arg->que_p, arg->sum));
+    return NULL;
+}
+
+int main(void)
+{
+    // N = 0
+    {
+        struct i64_bque *que_p = i64_bque_create(0);
+        if (que_p) {
+            assert(false);
+        }
+    }
+    // N = 1, try_enqueue * 3 -> try_dequeue * 3
+    {
+        struct i64_bque *que_p = i64_bque_create(1);
+        if (!que_p) {
+            assert(false);
+        }
+        assert(que_p->capacity == 2);
+        assert(i64_bque_count(que_p) == 0);
+
+        int64_t value;
+        assert(!i64_bque_try_dequeue(que_p, &value));
+        assert(i64_bque_try_enqueue(que_p, 42));
+        assert(i64_bque_try_enqueue(que_p, 43));
+        assert(!i64_bque_try_enqueue(que_p, 69));
+        assert(i64_bque_count(que_p) == 2);
+        assert(i64_bque_try_dequeue(que_p, &value) && value == 42);
+        assert(i64_bque_try_dequeue(que_p, &value) && value == 43);
+        assert(!i64_bque_try_dequeue(que_p, &value));
+        assert(i64_bque_count(que_p) == 0);
+
+        i64_bque_destroy(que_p);
+    }
+    // N = 10, enqueue * 16 (wrapping) -> dequeue * 16
+    {
+        struct i64_bque *que_p = i64_bque_create(10);
+        if (!que_p) {
+            assert(false);
+        }
+        assert(que_p->capacity == 16);
+
+        for (int64_t round = 0; round < 3; round++) {
+            for (int64_t i = 0; i < 16; i++) {
+                assert(i64_bque_enqueue_wait(que_p, 420 + i, 0));
+            }
+            assert(i64_bque_count(que_p) == 16);
+            for (int64_t i = 0; i < 16; i++) {
+                assert(i64_bque_dequeue(que_p) == 420 + i);
+            }
+        }
+
+        i64_bque_destroy(que_p);
+    }
+    // timeout on full / empty queue
+    {
+        struct i64_bque *que_p = i64_bque_create(1);
+        if (!que_p) {
+            assert(false);
+        }
+
+        int64_t value;
+        assert(!i64_bque_dequeue_wait(que_p, &value, 1000000));
+        i64_bque_enqueue(que_p, 42);
+        i64_bque_enqueue(que_p, 43);
+        assert(!i64_bque_enqueue_wait(que_p, 69, 1000000));
+        assert(i64_bque_dequeue_wait(que_p, &value, 1000000) && value == 42);
+
+        i64_bque_destroy(que_p);
+    }
+    // wake up blocked producer / consumer
+    {
+        struct i64_bque *que_p = i64_bque_create(1);
+        if (!que_p) {
+            assert(false);
+        }
+        pthread_t thread;
+
+        struct thread_arg arg = {.que_p = que_p, .sum = 69};
+        pthread_create(&thread, NULL, delayed_enqueue, &arg);
+
+        int64_t value;
+        assert(i64_bque_dequeue_wait(que_p, &value, FBQUEUE_WAIT_FOREVER) && value == 69);
+        pthread_join(thread, NULL);
+
+        i64_bque_enqueue(que_p, 42);
+        i64_bque_enqueue(que_p, 43);
+        pthread_create(&thread, NULL, delayed_dequeue, &arg);
+
+        assert(i64_bque_enqueue_wait(que_p, 44, 10000000000U));
+        pthread_join(thread, NULL);
+
+        assert(arg.sum == 42);
+        assert(i64_bque_dequeue(que_p) == 43);
+        assert(i64_bque_dequeue(que_p) == 44);
+
+        i64_bque_destroy(que_p);
+    }
+    // N = 1e+6, multiple producers and consumers
+    {
+        struct i64_bque *que_p = i64_bque_create(64);
+        if (!que_p) {
+            assert(false);
+        }
+
+        pthread_t producers[THREAD_COUNT], consumers[THREAD_COUNT];
+        struct thread_arg producer_args[THREAD_COUNT], consumer_args[THREAD_COUNT];
+
+        for (uint32_t i = 0; i < THREAD_COUNT; i++) {
+            producer_args[i] = (struct thread_arg){.que_p = que_p, .thread_index = i, .sum = 0};
+            consumer_args[i] = (struct thread_arg){.que_p = que_p, .thread_index = i, .sum = 0};
+            pthread_create(&consumers[i], NULL, consumer, &consumer_args[i]);
+            pthread_create(&producers[i], NULL, producer, &producer_args[i]);
+        }
+
+        int64_t produced_sum = 0;
+        int64_t consumed_sum = 0;
+        for (uint32_t i = 0; i < THREAD_COUNT; i++) {
+            pthread_join(producers[i], NULL);
+            pthread_join(consumers[i], NULL);
+            produced_sum += producer_args[i].sum;
+            consumed_sum += consumer_args[i].sum;
+        }
+
+        assert(produced_sum == (int64_t)VALUE_COUNT * (VALUE_COUNT - 1) / 2);
+        assert(consumed_sum == produced_sum);
+        assert(i64_bque_count(que_p) == 0);
+
+        i64_bque_destroy(que_p);
+    }
+}
@@ -0,0 +1,288 @@
+/*
+    Test cases (N):
+    - N := 0
+    - N := 1
+    - N := 10
+    - N := 1e+5
+
+    Non-mutating operation types / properties:
+    - .count
+    - .capacity
+    - is_empty
+    - is_full
+    - contains
+    - get_max / peek
+    - get_max_handle
+    - get_value
+    - get_priority
+    - fipqueue_for_each
+    - calc_sizeof (this is indirectly tested for with `create`)
+
+    PRIORITY_TYPE := uint64_t with a min-heap PRIORITY_IS_LESS is tested for with Dijkstra's algorithm (N := 6)
+    and with N := 1e+5.
+
+    Mutating operation types:
+    - push
+    - pop_max
+    - remove
+    - update_priority
+    - clear
+
+    Memory operations [to also be tested with sanitizers]:
+    - init (this is indirectly tested for with `create`)
+    - create
+    - destroy
+    - copy
+*/
+
+#define NAME       i64_ipque
+#define VALUE_TYPE int64_t
+#include "fipqueue.h"
+
+#define NAME                   i64_min_ipque
+#define VALUE_TYPE             int64_t
+#define PRIORITY_TYPE          uint64_t
+#define PRIORITY_IS_LESS(a, b) ((a) > (b))
+#include "fipqueue.h"
+
+static inline bool check_heap_and_positions(const struct i64_ipque *que_p)
+{
+    bool res = true;
+    for (uint32_t i = 0; i < que_p->count; i++) {
+        res &= que_p->positions[que_p->elements[i].handle] == i;
+        if (i > 0) {
+            res &= que_p->elements[(i - 1) / 2].priority >= que_p->elements[i].priority;
+        }
+    }
+    uint32_t queued = 0;
+    for (uint32_t handle = 0; handle < que_p->capacity; handle++) {
+        queued += i64_ipque_contains(que_p, handle);
+    }
+    return res && queued == que_p->count;
+}
+
+static inline bool check_min_heap_and_positions(const struct i64_min_ipque *que_p)
+{
+    bool res = true;
+    for (uint32_t i = 0; i < que_p->count; i++) {
+        res &= que_p->positions[que_p->elements[i].handle] == i;
+        if (i > 0) {
+            res &= que_p->elements[(i - 1) / 2].priority <= que_p->elements[i].priority;
+        }
+    }
+    uint32_t queued = 0;
+    for (uint32_t handle = 0; handle < que_p->capacity; handle++) {
+        queued += i64_min_ipque_contains(que_p, handle);
+    }
+    return res && queued == que_p->count;
+}
+
+int main(void)
+{
+    // N = 0
+    {
+        struct i64_ipque *que_p = i64_ipque_create(0);
+        if (que_p) {
+            assert(false);
+        }
+    }
+    // N = 1, push -> update_priority -> pop_max
+    {
+        struct i64_ipque *que_p = i64_ipque_create(1);
+        if (!que_p) {
+            assert(false);
+        }
+        assert(i64_ipque_is_empty(que_p));
+        assert(!i64_ipque_contains(que_p, 0));
+
+        i64_ipque_push(que_p, 0, 69, 42);
+
+        assert(i64_ipque_is_full(que_p));
+        assert(i64_ipque_contains(que_p, 0));
+        assert(i64_ipque_peek(que_p) == 69);
+        assert(i64_ipque_get_max_handle(que_p) == 0);
+        assert(i64_ipque_get_priority(que_p, 0) == 42);
+
+        i64_ipque_update_priority(que_p, 0, 7);
+        assert(i64_ipque_get_priority(que_p, 0) == 7);
+        assert(i64_ipque_get_value(que_p, 0) == 69);
+
+        assert(i64_ipque_pop_max(que_p) == 69);
+        assert(i64_ipque_is_empty(que_p));
+        assert(!i64_ipque_contains(que_p, 0));
+
+        i64_ipque_destroy(que_p);
+    }
+    // N = 10, push * 10 -> update_priority * 2 -> remove * 2 -> copy -> pop_max * 8
+    {
+        struct i64_ipque *que_p = i64_ipque_create(10);
+        if (!que_p) {
+            assert(false);
+        }
+        for (uint32_t handle = 0; handle < 10; handle++) {
+            i64_ipque_push(que_p, handle, 420 + handle, handle + 1);
+        }
+        assert(i64_ipque_is_full(que_p));
+        assert(i64_ipque_peek(que_p) == 429);
+        assert(check_heap_and_positions(que_p));
+
+        i64_ipque_update_priority(que_p, 0, 100);
+        assert(i64_ipque_get_max_handle(que_p) == 0);
+        assert(check_heap_and_positions(que_p));
+
+        i64_ipque_update_priority(que_p, 0, 0);
+        assert(i64_ipque_get_max_handle(que_p) == 9);
+        assert(check_heap_and_positions(que_p));
+
+        assert(i64_ipque_remove(que_p, 9) == 429);
+        assert(i64_ipque_remove(que_p, 4) == 424);
+        assert(!i64_ipque_contains(que_p, 9));
+        assert(!i64_ipque_contains(que_p, 4));
+        assert(que_p->count == 8);
+        assert(check_heap_and_positions(que_p));
+
+        {
+            uint32_t index, handle;
+            int64_t value;
+            int64_t sum = 0;
+            fipqueue_for_each(que_p, index, handle, value)
+            {
+                assert(value == 420 + handle);
+                sum += value;
+            }
+            assert(sum == 8 * 420 + 45 - 9 - 4);
+        }
+
+        struct i64_ipque *que_copy_p = i64_ipque_create(10);
+        if (!que_copy_p) {
+            assert(false);
+        }
+        i64_ipque_copy(que_copy_p, que_p);
+        assert(check_heap_and_positions(que_copy_p));
+
+        const int64_t expected[8] = {428, 427, 426, 425, 423, 422, 421, 420};
+        for (uint32_t i = 0; i < 8; i++) {
+            assert(i64_ipque_pop_max(que_copy_p) == expected[i]);
+            assert(check_heap_and_positions(que_copy_p));
+        }
+        assert(i64_ipque_is_empty(que_copy_p));
+
+        i64_ipque_clear(que_p);
+        assert(i64_ipque_is_empty(que_p));
+        assert(check_heap_and_positions(que_p));
+
+        i64_ipque_destroy(que_copy_p);
+        i64_ipque_destroy(que_p);
+    }
+    // N = 1e+5, push * 1e+5 -> (update_priority, remove) * 5e+4 -> pop_max * 5e+4
+    {
+        const uint32_t n = (uint32_t)1e+5;
+        struct i64_ipque *que_p = i64_ipque_create(n);
+        if (!que_p) {
+            assert(false);
+        }
+        srand(42);
+        for (uint32_t handle = 0; handle < n; handle++) {
+            i64_ipque_push(que_p, handle, (int64_t)handle, (uint32_t)rand() % 1000);
+        }
+        for (uint32_t handle = 0; handle < n; handle += 2) {
+            i64_ipque_update_priority(que_p, handle, (uint32_t)rand() % 1000);
+            assert(i64_ipque_remove(que_p, handle + 1) == (int64_t)handle + 1);
+        }
+        assert(que_p->count == n / 2);
+        assert(check_heap_and_positions(que_p));
+
+        uint32_t prev = UINT32_MAX;
+        while (!i64_ipque_is_empty(que_p)) {
+            const uint32_t handle = i64_ipque_get_max_handle(que_p);
+            const uint32_t curr = i64_ipque_get_priority(que_p, handle);
+            assert(handle % 2 == 0);
+            assert(prev >= curr);
+            assert(i64_ipque_pop_max(que_p) == (int64_t)handle);
+            prev = curr;
+        }
+
+        i64_ipque_destroy(que_p);
+    }
+    // PRIORITY_TYPE = uint64_t, min-heap, Dijkstra's algorithm with N = 6, push -> (pop_max, update_priority)
+    {
+        /* edge weights scaled such that the distances don't fit in 32 bits */
+        const uint64_t scale = (uint64_t)1e+10;
+        const uint32_t edges[9][3] = {{0, 1, 7},  {0, 2, 9},  {0, 5, 14}, {1, 2, 10}, {1, 3, 15},
+                                      {2, 3, 11}, {2, 5, 2},  {3, 4, 6},  {4, 5, 9}};
+        const uint64_t expected[6] = {0, 7, 9, 20, 20, 11};
+
+        uint64_t dist[6];
+        bool done[6] = {false};
+        for (uint32_t v = 0; v < 6; v++) {
+            dist[v] = UINT64_MAX;
+        }
+
+        struct i64_min_ipque *que_p = i64_min_ipque_create(6);
+        if (!que_p) {
+            assert(false);
+        }
+        dist[0] = 0;
+        i64_min_ipque_push(que_p, 0, 0, 0);
+
+        while (!i64_min_ipque_is_empty(que_p)) {
+            const uint32_t u = i64_min_ipque_get_max_handle(que_p);
+            assert(i64_min_ipque_get_priority(que_p, u) == dist[u]);
+            (void)(i64_min_ipque_pop_max(que_p));
+            done[u] = true;
+
+            for (uint32_t i = 0; i < 9; i++) {
+                for (uint32_t side = 0; side < 2; side++) {
+                    const uint32_t from = edges[i][side], to = edges[i][1 - side];
+                    const uint64_t alt = dist[u] + edges[i][2] * scale;
+                    if (from != u || done[to] || alt >= dist[to]) {
+                        continue;
+                    }
+                    dist[to] = alt;
+                    if (i64_min_ipque_contains(que_p, to)) {
+                        i64_min_ipque_update_priority(que_p, to, alt);
+                    }
+                    else {
+                        i64_min_ipque_push(que_p, to, to, alt);
+                    }
+                    assert(check_min_heap_and_positions(que_p));
+                }
+            }
+        }
+        for (uint32_t v = 0; v < 6; v++) {
+            assert(dist[v] == expected[v] * scale);
+        }
+
+        i64_min_ipque_destroy(que_p);
+    }
+    // PRIORITY_TYPE = uint64_t, min-heap, N = 1e+5, push * 1e+5 -> (update_priority, remove) * 5e+4 -> pop_max * 5e+4
+    {
+        const uint32_t n = (uint32_t)1e+5;
+        struct i64_min_ipque *que_p = i64_min_ipque_create(n);
+        if (!que_p) {
+            assert(false);
+        }
+        srand(42);
+        for (uint32_t handle = 0; handle < n; handle++) {
+            i64_min_ipque_push(que_p, handle, (int64_t)handle, ((uint64_t)rand() << 32) | (uint64_t)rand());
+        }
+        for (uint32_t handle = 0; handle < n; handle += 2) {
+            i64_min_ipque_update_priority(que_p, handle, ((uint64_t)rand() << 32) | (uint64_t)rand());
+            assert(i64_min_ipque_remove(que_p, handle + 1) == (int64_t)handle + 1);
+        }
+        assert(que_p->count == n / 2);
+        assert(check_min_heap_and_positions(que_p));
+
+        uint64_t prev = 0;
+        while (!i64_min_ipque_is_empty(que_p)) {
+            const uint32_t handle = i64_min_ipque_get_max_handle(que_p);
+            const uint64_t curr = i64_min_ipque_get_priority(que_p, handle);
+            assert(handle % 2 == 0);
+            assert(prev <= curr);
+            assert(i64_min_ipque_pop_max(que_p) == (int64_t)handle);
+            prev = curr;
+        }
+
+        i64_min_ipque_destroy(que_p);
+    }
+}
@@ -0,0 +1,201 @@
+/*
+    Test cases (N):
+    - N := 0
+    - N := 1
+    - N := 2
+    - N := 10
+    - N := 1e+5
+
+    Non-mutating operation types / properties:
+    - .count
+    - .capacity
+    - is_empty
+    - is_full
+    - get_min
+    - get_max
+    - fminmaxheap_for_each
+    - calc_sizeof (this is indirectly tested for with `create`)
+
+    Mutating operation types:
+    - push
+    - pop_min
+    - pop_max
+    - clear
+
+    Memory operations [to also be tested with sanitizers]:
+    - init (this is indirectly tested for with `create`)
+    - create
+    - destroy
+    - copy
+*/
+
+#include <stdint.h>
+
+#define NAME       i64_mmheap
+#define VALUE_TYPE int64_t
+#include "fminmaxheap.h"
+
+/* every element is not less than its descendants on max levels, and not greater on min levels */
+static inline bool check_heap(const struct i64_mmheap *heap_p)
+{
+    bool res = true;
+    for (uint32_t i = 1; i < heap_p->count; i++) {
+        for (uint32_t j = (i - 1) / 2, k = i; k > 0; k = j, j = (j - 1) / 2) {
+            if (internal_fminmaxheap_is_min_level(j)) {
+                res &= heap_p->elements[j].priority <= heap_p->elements[i].priority;
+            }
+            else {
+                res &= heap_p->elements[j].priority >= heap_p->elements[i].priority;
+            }
+        }
+    }
+    return res;
+}
+
+int main(void)
+{
+    // N = 0
+    {
+        struct i64_mmheap *heap_p = i64_mmheap_create(0);
+        if (heap_p) {
+            assert(false);
+        }
+    }
+    // N = 1, push -> pop_max
+    {
+        struct i64_mmheap *heap_p = i64_mmheap_create(1);
+        if (!heap_p) {
+            assert(false);
+        }
+        assert(heap_p->capacity == 1);
+        assert(i64_mmheap_is_empty(heap_p));
+
+        i64_mmheap_push(heap_p, 42, 1);
+
+        assert(i64_mmheap_is_full(heap_p));
+        assert(i64_mmheap_get_min(heap_p) == 42);
+        assert(i64_mmheap_get_max(heap_p) == 42);
+        assert(i64_mmheap_pop_max(heap_p) == 42);
+        assert(i64_mmheap_is_empty(heap_p));
+
+        i64_mmheap_destroy(heap_p);
+    }
+    // N = 2, push * 2 -> pop_min -> pop_max
+    {
+        struct i64_mmheap *heap_p = i64_mmheap_create(2);
+        if (!heap_p) {
+            assert(false);
+        }
+        i64_mmheap_push(heap_p, 1, 1);
+        i64_mmheap_push(heap_p, 2, 2);
+
+        assert(i64_mmheap_get_min(heap_p) == 1);
+        assert(i64_mmheap_get_max(heap_p) == 2);
+        assert(i64_mmheap_pop_min(heap_p) == 1);
+        assert(i64_mmheap_get_max(heap_p) == 2);
+        assert(i64_mmheap_pop_max(heap_p) == 2);
+        assert(i64_mmheap_is_empty(heap_p));
+
+        i64_mmheap_destroy(heap_p);
+    }
+    // N = 10, push * 10 -> copy -> (pop_min, pop_max) * 5
+    {
+        struct i64_mmheap *heap_p = i64_mmheap_create(10);
+        struct i64_mmheap *heap_copy_p = i64_mmheap_create(10);
+        if (!heap_p || !heap_copy_p) {
+            assert(false);
+        }
+        for (uint32_t i = 0; i < 10; i++) {
+            const uint32_t priority = (i * 7) % 10;
+            i64_mmheap_push(heap_p, (int64_t)priority, priority);
+            assert(check_heap(heap_p));
+        }
+        assert(i64_mmheap_is_full(heap_p));
+        {
+            uint32_t index;
+            int64_t value;
+            int64_t sum = 0;
+            fminmaxheap_for_each(heap_p, index, value)
+            {
+                sum += value;
+            }
+            assert(sum == 45);
+        }
+        i64_mmheap_copy(heap_copy_p, heap_p);
+        i64_mmheap_clear(heap_p);
+        assert(i64_mmheap_is_empty(heap_p));
+
+        for (int64_t i = 0; i < 5; i++) {
+            assert(i64_mmheap_pop_min(heap_copy_p) == i);
+            assert(check_heap(heap_copy_p));
+            assert(i64_mmheap_pop_max(heap_copy_p) == 9 - i);
+            assert(check_heap(heap_copy_p));
+        }
+        assert(i64_mmheap_is_empty(heap_copy_p));
+
+        i64_mmheap_destroy(heap_copy_p);
+        i64_mmheap_destroy(heap_p);
+    }
+    // N = 1e+5, push * 1e+5 -> (pop_min | pop_max | push) * 3e+5 -> (pop_min | pop_max) * rest
+    {
+        struct i64_mmheap *heap_p = i64_mmheap_create(1e+5);
+        if (!heap_p) {
+            assert(false);
+        }
+        /* priorities are in [0, 1000). the number of each is tracked to find the expected min and max */
+        static uint32_t priority_count[1000];
+
+        srand(42);
+        for (size_t i = 0; i < 1e+5; i++) {
+            const uint32_t priority = (uint32_t)rand() % 1000;
+            i64_mmheap_push(heap_p, (int64_t)priority, priority);
+            priority_count[priority]++;
+        }
+        assert(check_heap(heap_p));
+
+        uint32_t min_priority = 0;
+        uint32_t max_priority = 999;
+        for (size_t i = 0; i < 3e+5 || !i64_mmheap_is_empty(heap_p); i++) {
+            const int op = rand() % 3;
+
+            if (i % 10000 == 0) {
+                assert(check_heap(heap_p));
+            }
+
+            if (op == 2 && i < 3e+5) {
+                if (i64_mmheap_is_full(heap_p)) {
+                    continue;
+                }
+                const uint32_t priority = (uint32_t)rand() % 1000;
+                i64_mmheap_push(heap_p, (int64_t)priority, priority);
+                priority_count[priority]++;
+                min_priority = priority < min_priority ? priority : min_priority;
+                max_priority = priority > max_priority ? priority : max_priority;
+                continue;
+            }
+            if (i64_mmheap_is_empty(heap_p)) {
+                continue;
+            }
+            while (priority_count[min_priority] == 0) {
+                min_priority++;
+            }
+            while (priority_count[max_priority] == 0) {
+                max_priority--;
+            }
+            assert(i64_mmheap_get_min(heap_p) == (int64_t)min_priority);
+            assert(i64_mmheap_get_max(heap_p) == (int64_t)max_priority);
+
+            if (op == 0) {
+                assert(i64_mmheap_pop_min(heap_p) == (int64_t)min_priority);
+                priority_count[min_priority]--;
+            }
+            else {
+                assert(i64_mmheap_pop_max(heap_p) == (int64_t)max_priority);
+                priority_count[max_priority]--;
+            }
+        }
+        assert(check_heap(heap_p));
+
+        i64_mmheap_destroy(heap_p);
+    }
+}
@@ -4,6 +4,7 @@
     - N := 1
     - N := 2
     - N := 10
+    - N := 1e+5
     - N := 1e+6
 
     Non-mutating operation types / properties:
@@ -16,14 +17,25 @@
     - calc_sizeof (this is indirectly tested for with `create`)
     - fpqueue_left_child + fpqueue_right_child + fpqueue_parent
 
+    ARITY := 4 is tested for with N := 1e+5.
+    PRIORITY_TYPE := uint64_t with a min-heap PRIORITY_IS_LESS is tested for with N := 1e+5.
+    PRIORITY_TYPE := struct with a composite PRIORITY_IS_LESS is tested for with N := 10.
+    Bounded top-K (K := 100) is tested for with a min-heap and N := 1e+5.
+    STABLE is tested for with N := 1e+5, and with push_n, create_from_array and push_bounded with N := 10.
+
     Mutating operation types:
     - push
+    - push_n
+    - push_bounded
     - pop_max
+    - replace_max
+    - drain_sorted
     - clear
 
     Memory operations [to also be tested with sanitizers]:
     - init (this is indirectly tested for with `create`)
     - create
+    - create_from_array
     - destroy
     - copy
 */
@@ -32,6 +44,50 @@
 #define VALUE_TYPE int64_t
 #include "fpqueue.h"
 
+#define NAME       i64_pque4
+#define VALUE_TYPE int64_t
+#define ARITY      4
+#include "fpqueue.h"
+
+#define NAME                   i64_min_pque
+#define VALUE_TYPE             int64_t
+#define PRIORITY_TYPE          uint64_t
+#define PRIORITY_IS_LESS(a, b) ((a) > (b))
+#include "fpqueue.h"
+
+#define NAME       i64_stable_pque
+#define VALUE_TYPE int64_t
+#define STABLE
+#include "fpqueue.h"
+
+#define NAME                   i64_stable_min_pque
+#define VALUE_TYPE             int64_t
+#define PRIORITY_IS_LESS(a, b) ((a) > (b))
+#define STABLE
+#include "fpqueue.h"
+
+static_assert(sizeof(struct i64_pque_element) == sizeof(struct {
+                  uint32_t priority;
+                  int64_t value;
+              }),
+              "elements are not widened without STABLE");
+
+struct deadline {
+    uint64_t time;
+    uint32_t seq;
+};
+
+static inline bool deadline_is_later(const struct deadline a, const struct deadline b)
+{
+    return a.time > b.time || (a.time == b.time && a.seq > b.seq);
+}
+
+#define NAME                   i64_deadline_pque
+#define VALUE_TYPE             int64_t
+#define PRIORITY_TYPE          struct deadline
+#define PRIORITY_IS_LESS(a, b) deadline_is_later(a, b)
+#include "fpqueue.h"
+
 static inline bool check_count_invariance(const struct i64_pque *que_p, const size_t push_op_count,
                                           const size_t pop_op_count)
 {
@@ -305,4 +361,257 @@ int main(void)
 
         i64_pque_destroy(que_p);
     }
+    // N = 10, create_from_array
+    {
+        struct i64_pque_element elements[10];
+        for (uint32_t i = 0; i < 10; i++) {
+            elements[i] = (struct i64_pque_element){.priority = (i * 7) % 10, .value = 420 + (i * 7) % 10};
+        }
+        struct i64_pque *que_p = i64_pque_create_from_array(10, elements, 10);
+        if (!que_p) {
+            assert(false);
+        }
+
+        assert(i64_pque_peek(que_p) == 429);
+        assert(check_count_invariance(que_p, 10, 0));
+        assert(check_capacity_invariance(que_p, 10));
+        assert(check_empty_full(que_p, 10, 0));
+        assert(check_priority_queue_property(que_p, 9));
+        assert(check_heap_property(que_p, 0));
+        assert(copy_values_and_check_ordered_values(que_p));
+
+        for (int64_t i = 9; i >= 0; i--) {
+            assert(i64_pque_pop_max(que_p) == 420 + i);
+        }
+
+        i64_pque_destroy(que_p);
+
+        assert(i64_pque_create_from_array(5, elements, 10) == NULL);
+    }
+    // N = 1e+5, push * 10 -> push_n(10) -> push_n(1e+5 - 20) -> pop_max * 1e+5
+    {
+        struct i64_pque *que_p = i64_pque_create(1e+5);
+        struct i64_pque_element *elements = malloc(sizeof(struct i64_pque_element) * (size_t)1e+5);
+        if (!que_p || !elements) {
+            assert(false);
+        }
+        srand(42);
+        for (uint32_t i = 0; i < 1e+5; i++) {
+            const uint32_t priority = (uint32_t)rand() % 1000;
+            elements[i] = (struct i64_pque_element){.priority = priority, .value = (int64_t)priority};
+        }
+        for (uint32_t i = 0; i < 10; i++) {
+            i64_pque_push(que_p, elements[i].value, elements[i].priority);
+        }
+        i64_pque_push_n(que_p, &elements[10], 10);
+        assert(check_count_invariance(que_p, 20, 0));
+        for (uint32_t i = 1; i < que_p->count; i++) {
+            assert(que_p->elements[fpqueue_parent(i)].priority >= que_p->elements[i].priority);
+        }
+
+        i64_pque_push_n(que_p, &elements[20], (uint32_t)1e+5 - 20);
+        assert(check_count_invariance(que_p, 1e+5, 0));
+        assert(i64_pque_is_full(que_p));
+        for (uint32_t i = 1; i < que_p->count; i++) {
+            assert(que_p->elements[fpqueue_parent(i)].priority >= que_p->elements[i].priority);
+        }
+
+        int64_t prev = INT64_MAX;
+        while (!i64_pque_is_empty(que_p)) {
+            const int64_t curr = i64_pque_pop_max(que_p);
+            assert(prev >= curr);
+            prev = curr;
+        }
+
+        free(elements);
+        i64_pque_destroy(que_p);
+    }
+    // N = 1e+5, push_n(1e+5) into an empty queue -> pop_max * 1e+5
+    {
+        struct i64_pque_element *elements = malloc(sizeof(struct i64_pque_element) * (size_t)1e+5);
+        if (!elements) {
+            assert(false);
+        }
+        for (uint32_t i = 0; i < 1e+5; i++) {
+            elements[i] = (struct i64_pque_element){.priority = i, .value = (int64_t)i};
+        }
+        struct i64_pque *que_p = i64_pque_create(1e+5);
+        struct i64_pque *heapified_p = i64_pque_create_from_array(1e+5, elements, 1e+5);
+        if (!que_p || !heapified_p) {
+            assert(false);
+        }
+
+        i64_pque_push_n(que_p, elements, 1e+5);
+        assert(check_count_invariance(que_p, 1e+5, 0));
+        for (uint32_t i = 1; i < que_p->count; i++) {
+            assert(que_p->elements[fpqueue_parent(i)].priority >= que_p->elements[i].priority);
+        }
+
+        // ascending priorities end up in a different layout when pushed one by one, so this checks that the heap was
+        // rebuilt the same way as create_from_array does:
+        for (uint32_t i = 0; i < que_p->count; i++) {
+            assert(que_p->elements[i].priority == heapified_p->elements[i].priority);
+        }
+
+        int64_t prev = INT64_MAX;
+        while (!i64_pque_is_empty(que_p)) {
+            const int64_t curr = i64_pque_pop_max(que_p);
+            assert(prev > curr);
+            prev = curr;
+        }
+
+        free(elements);
+        i64_pque_destroy(heapified_p);
+        i64_pque_destroy(que_p);
+    }
+    // ARITY = 4, N = 1e+5, push * 1e+5 -> pop_max * 1e+5
+    {
+        struct i64_pque4 *que_p = i64_pque4_create(1e+5);
+        if (!que_p) {
+            assert(false);
+        }
+        srand(42);
+        for (size_t i = 0; i < 1e+5; i++) {
+            const uint32_t priority = (uint32_t)rand() % 1000;
+            i64_pque4_push(que_p, (int64_t)priority, priority);
+        }
+        for (uint32_t i = 1; i < que_p->count; i++) {
+            assert(que_p->elements[(i - 1) / 4].priority >= que_p->elements[i].priority);
+        }
+        int64_t prev = INT64_MAX;
+        while (!i64_pque4_is_empty(que_p)) {
+            const int64_t curr = i64_pque4_pop_max(que_p);
+            assert(prev >= curr);
+            prev = curr;
+        }
+
+        i64_pque4_destroy(que_p);
+    }
+    // PRIORITY_TYPE = uint64_t, min-heap, N = 1e+5, push * 1e+5 -> pop_max * 1e+5
+    {
+        struct i64_min_pque *que_p = i64_min_pque_create(1e+5);
+        if (!que_p) {
+            assert(false);
+        }
+        srand(42);
+        for (size_t i = 0; i < 1e+5; i++) {
+            const uint64_t priority = ((uint64_t)rand() << 32) | (uint64_t)rand();
+            i64_min_pque_push(que_p, (int64_t)(priority >> 1), priority);
+        }
+        int64_t prev = INT64_MIN;
+        while (!i64_min_pque_is_empty(que_p)) {
+            const int64_t curr = i64_min_pque_pop_max(que_p);
+            assert(prev <= curr);
+            prev = curr;
+        }
+
+        i64_min_pque_destroy(que_p);
+    }
+    // PRIORITY_TYPE = struct deadline, N = 10, push * 10 -> pop_max * 10
+    {
+        struct i64_deadline_pque *que_p = i64_deadline_pque_create(10);
+        if (!que_p) {
+            assert(false);
+        }
+        for (uint32_t i = 0; i < 10; i++) {
+            const struct deadline deadline = {.time = (i * 7) % 5, .seq = i};
+            i64_deadline_pque_push(que_p, (int64_t)i, deadline);
+        }
+        const int64_t expected[10] = {0, 5, 3, 8, 1, 6, 4, 9, 2, 7};
+        for (uint32_t i = 0; i < 10; i++) {
+            assert(i64_deadline_pque_pop_max(que_p) == expected[i]);
+        }
+
+        i64_deadline_pque_destroy(que_p);
+    }
+    // min-heap, K = 100, N = 1e+5, push_bounded * 1e+5 -> drain_sorted
+    {
+        struct i64_min_pque *que_p = i64_min_pque_create(100);
+        if (!que_p) {
+            assert(false);
+        }
+        uint32_t kept_count = 0;
+        for (uint64_t i = 0; i < 1e+5; i++) {
+            const uint64_t priority = (i * 7919) % 100000;
+            kept_count += i64_min_pque_push_bounded(que_p, (int64_t)priority, priority);
+        }
+        assert(que_p->count == 100);
+        assert(kept_count < 1e+4);
+        assert(i64_min_pque_get_max(que_p) == 99900);
+
+        assert(i64_min_pque_replace_max(que_p, 100000, 100000) == 99900);
+        assert(i64_min_pque_get_max(que_p) == 99901);
+        assert(i64_min_pque_push_bounded(que_p, 0, 0) == false);
+
+        assert(i64_min_pque_drain_sorted(que_p) == 100);
+        assert(i64_min_pque_is_empty(que_p));
+        assert(que_p->elements[0].value == 100000);
+        for (uint32_t i = 1; i < 100; i++) {
+            assert(que_p->elements[i].value == (int64_t)(100000 - i));
+        }
+
+        i64_min_pque_destroy(que_p);
+    }
+    // STABLE, N = 1e+5, push * 1e+5 -> pop_max * 1e+5
+    {
+        struct i64_stable_pque *que_p = i64_stable_pque_create(1e+5);
+        if (!que_p) {
+            assert(false);
+        }
+        srand(42);
+        for (int64_t i = 0; i < 1e+5; i++) {
+            i64_stable_pque_push(que_p, i, (uint32_t)rand() % 100);
+        }
+        uint32_t prev_priority = UINT32_MAX;
+        int64_t prev = -1;
+        while (!i64_stable_pque_is_empty(que_p)) {
+            const uint32_t priority = que_p->elements[0].priority;
+            const int64_t curr = i64_stable_pque_pop_max(que_p);
+            assert(prev_priority >= priority);
+            assert(prev_priority != priority || prev < curr);
+            prev_priority = priority;
+            prev = curr;
+        }
+
+        i64_stable_pque_destroy(que_p);
+    }
+    // STABLE, N = 10, create_from_array -> push_n -> pop_max * 10
+    {
+        struct i64_stable_pque_element elements[5];
+        for (uint32_t i = 0; i < 5; i++) {
+            elements[i] = (struct i64_stable_pque_element){.priority = i % 2, .value = (int64_t)i};
+        }
+        struct i64_stable_pque *que_p = i64_stable_pque_create_from_array(10, elements, 5);
+        if (!que_p) {
+            assert(false);
+        }
+        for (uint32_t i = 0; i < 5; i++) {
+            elements[i].value += 5;
+        }
+        i64_stable_pque_push_n(que_p, elements, 5);
+
+        const int64_t expected[10] = {1, 3, 6, 8, 0, 2, 4, 5, 7, 9};
+        for (uint32_t i = 0; i < 10; i++) {
+            assert(i64_stable_pque_pop_max(que_p) == expected[i]);
+        }
+
+        i64_stable_pque_destroy(que_p);
+    }
+    // STABLE, min-heap, K = 3, N = 10, push_bounded * 10 -> drain_sorted
+    {
+        struct i64_stable_min_pque *que_p = i64_stable_min_pque_create(3);
+        if (!que_p) {
+            assert(false);
+        }
+        for (uint32_t i = 0; i < 10; i++) {
+            i64_stable_min_pque_push_bounded(que_p, (int64_t)i, i < 5 ? 1 : 0);
+        }
+        /* ties are evicted in FIFO order, such that the latest of the equal priorities are kept */
+        assert(i64_stable_min_pque_drain_sorted(que_p) == 3);
+        assert(que_p->elements[0].value == 4);
+        assert(que_p->elements[1].value == 3);
+        assert(que_p->elements[2].value == 2);
+
+        i64_stable_min_pque_destroy(que_p);
+    }
 }
@@ -0,0 +1,162 @@
+/*
+    Test cases (N):
+    - N := 0
+    - N := 1
+    - N := 10
+    - N := 1e+5
+
+    ARITY := 2, 4, 8 are tested for with N := 1e+5.
+
+    Non-mutating operation types / properties:
+    - .count
+    - .capacity
+    - is_empty
+    - is_full
+    - get_max / peek
+
+    Mutating operation types:
+    - push
+    - pop_max
+    - clear
+
+    Memory operations [to also be tested with sanitizers]:
+    - create
+    - destroy
+*/
+
+#include <stdint.h>
+
+struct large_value {
+    int64_t data[8];
+};
+
+#define NAME       large_pque
+#define VALUE_TYPE struct large_value
+#include "fpqueue_soa.h"
+
+#define NAME       i64_pque2
+#define VALUE_TYPE int64_t
+#define ARITY      2
+#include "fpqueue_soa.h"
+
+#define NAME       i64_pque4
+#define VALUE_TYPE int64_t
+#define ARITY      4
+#include "fpqueue_soa.h"
+
+#define NAME       i64_pque8
+#define VALUE_TYPE int64_t
+#define ARITY      8
+#include "fpqueue_soa.h"
+
+#define CHECK_HEAP_PROPERTY(que_p, arity, res)                                                                       \
+    do {                                                                                                             \
+        (res) = true;                                                                                                \
+        for (uint32_t i = 1; i < (que_p)->count; i++) {                                                              \
+            (res) &= (que_p)->priorities[(i - 1) / (arity)] >= (que_p)->priorities[i];                               \
+            (res) &= (que_p)->values[(que_p)->slots[i]] == (int64_t)(que_p)->priorities[i];                          \
+        }                                                                                                            \
+        for (uint32_t i = (que_p)->count; i < (que_p)->capacity + (arity) - 1; i++) {                                \
+            (res) &= (que_p)->priorities[i] == 0;                                                                    \
+        }                                                                                                            \
+    } while (false)
+
+#define TEST_RANDOM_PUSH_POP(pque_name, arity)                                                                       \
+    do {                                                                                                             \
+        struct pque_name *que_p = pque_name##_create(1e+5);                                                          \
+        if (!que_p) {                                                                                                \
+            assert(false);                                                                                           \
+        }                                                                                                            \
+        srand(42);                                                                                                   \
+        for (size_t i = 0; i < 1e+5; i++) {                                                                          \
+            const uint32_t priority = (uint32_t)rand() % 1000;                                                       \
+            pque_name##_push(que_p, (int64_t)priority, priority);                                                    \
+        }                                                                                                            \
+        assert(pque_name##_is_full(que_p));                                                                          \
+        bool res;                                                                                                    \
+        CHECK_HEAP_PROPERTY(que_p, arity, res);                                                                      \
+        assert(res);                                                                                                 \
+        for (size_t i = 0; i < 5e+4; i++) {                                                                          \
+            pque_name##_pop_max(que_p);                                                                              \
+        }                                                                                                            \
+        CHECK_HEAP_PROPERTY(que_p, arity, res);                                                                      \
+        assert(res);                                                                                                 \
+        for (size_t i = 0; i < 5e+4; i++) {                                                                          \
+            const uint32_t priority = (uint32_t)rand() % 1000;                                                       \
+            pque_name##_push(que_p, (int64_t)priority, priority);                                                    \
+        }                                                                                                            \
+        int64_t prev = INT64_MAX;                                                                                    \
+        while (!pque_name##_is_empty(que_p)) {                                                                       \
+            const int64_t curr = pque_name##_pop_max(que_p);                                                         \
+            assert(prev >= curr);                                                                                    \
+            prev = curr;                                                                                             \
+        }                                                                                                            \
+        pque_name##_destroy(que_p);                                                                                  \
+    } while (false)
+
+int main(void)
+{
+    // N = 0
+    {
+        struct large_pque *que_p = large_pque_create(0);
+        if (que_p) {
+            assert(false);
+        }
+    }
+    // N = 1, push -> pop_max
+    {
+        struct large_pque *que_p = large_pque_create(1);
+        if (!que_p) {
+            assert(false);
+        }
+        assert(large_pque_is_empty(que_p));
+
+        large_pque_push(que_p, (struct large_value){{69}}, 42);
+
+        assert(que_p->count == 1);
+        assert(large_pque_is_full(que_p));
+        assert(large_pque_peek(que_p).data[0] == 69);
+        assert(large_pque_pop_max(que_p).data[0] == 69);
+        assert(large_pque_is_empty(que_p));
+
+        large_pque_destroy(que_p);
+    }
+    // N = 10, push * 10 -> pop_max * 5 -> clear -> push * 5 -> pop_max * 5
+    {
+        struct large_pque *que_p = large_pque_create(10);
+        if (!que_p) {
+            assert(false);
+        }
+        for (uint32_t i = 0; i < 10; i++) {
+            large_pque_push(que_p, (struct large_value){{420 + (int64_t)((i * 7) % 10), [7] = -1}}, (i * 7) % 10);
+        }
+        assert(large_pque_is_full(que_p));
+        assert(large_pque_get_max(que_p).data[0] == 429);
+
+        for (int64_t i = 9; i >= 5; i--) {
+            const struct large_value value = large_pque_pop_max(que_p);
+            assert(value.data[0] == 420 + i);
+            assert(value.data[7] == -1);
+        }
+        assert(que_p->count == 5);
+
+        large_pque_clear(que_p);
+        assert(large_pque_is_empty(que_p));
+
+        for (uint32_t i = 0; i < 5; i++) {
+            large_pque_push(que_p, (struct large_value){{430 + (int64_t)i}}, i);
+        }
+        for (int64_t i = 4; i >= 0; i--) {
+            assert(large_pque_pop_max(que_p).data[0] == 430 + i);
+        }
+        assert(large_pque_is_empty(que_p));
+
+        large_pque_destroy(que_p);
+    }
+    // ARITY = 2, 4, 8, N = 1e+5, push * 1e+5 -> pop_max * 5e+4 -> push * 5e+4 -> pop_max * 1e+5
+    {
+        TEST_RANDOM_PUSH_POP(i64_pque2, 2);
+        TEST_RANDOM_PUSH_POP(i64_pque4, 4);
+        TEST_RANDOM_PUSH_POP(i64_pque8, 8);
+    }
+}
@@ -0,0 +1,166 @@
+/*
+    Test cases (N):
+    - N := 0
+    - N := 1
+    - N := 10
+    - N := 1e+5
+
+    KEY_TYPE := uint64_t is tested for with N := 1e+5.
+
+    Non-mutating operation types / properties:
+    - .count
+    - .capacity
+    - is_empty
+    - is_full
+
+    Mutating operation types:
+    - push
+    - pop_min
+    - get_min / peek
+    - get_min_key
+    - clear
+
+    Memory operations [to also be tested with sanitizers]:
+    - init (this is indirectly tested for with `create`)
+    - create
+    - destroy
+*/
+
+#include <stdint.h>
+
+#define NAME       i64_rheap
+#define VALUE_TYPE int64_t
+#include "fradixheap.h"
+
+#define NAME       i64_rheap64
+#define VALUE_TYPE int64_t
+#define KEY_TYPE   uint64_t
+#include "fradixheap.h"
+
+int main(void)
+{
+    // N = 0
+    {
+        struct i64_rheap *heap_p = i64_rheap_create(0);
+        if (heap_p) {
+            assert(false);
+        }
+    }
+    // N = 1, push -> pop_min -> push -> pop_min
+    {
+        struct i64_rheap *heap_p = i64_rheap_create(1);
+        if (!heap_p) {
+            assert(false);
+        }
+        assert(i64_rheap_is_empty(heap_p));
+
+        i64_rheap_push(heap_p, 69, 42);
+
+        assert(i64_rheap_is_full(heap_p));
+        assert(i64_rheap_get_min_key(heap_p) == 42);
+        assert(i64_rheap_peek(heap_p) == 69);
+        assert(i64_rheap_pop_min(heap_p) == 69);
+        assert(i64_rheap_is_empty(heap_p));
+
+        i64_rheap_push(heap_p, 70, 42);
+        assert(i64_rheap_pop_min(heap_p) == 70);
+        assert(heap_p->count == 0);
+
+        i64_rheap_destroy(heap_p);
+    }
+    // N = 10, push * 10 -> pop_min * 5 -> push * 5 -> clear -> push * 5 -> pop_min * 5
+    {
+        struct i64_rheap *heap_p = i64_rheap_create(10);
+        if (!heap_p) {
+            assert(false);
+        }
+        for (uint32_t i = 0; i < 10; i++) {
+            const uint32_t key = (i * 7) % 10 + 100;
+            i64_rheap_push(heap_p, (int64_t)key, key);
+        }
+        assert(i64_rheap_is_full(heap_p));
+
+        for (int64_t i = 0; i < 5; i++) {
+            assert(i64_rheap_pop_min(heap_p) == 100 + i);
+        }
+        assert(heap_p->count == 5);
+        assert(heap_p->last_key == 104);
+
+        for (uint32_t i = 0; i < 5; i++) {
+            i64_rheap_push(heap_p, (int64_t)(104 + 3 * i), 104 + 3 * i);
+        }
+        const int64_t expected[10] = {104, 105, 106, 107, 107, 108, 109, 110, 113, 116};
+        for (uint32_t i = 0; i < 10; i++) {
+            assert(i64_rheap_get_min_key(heap_p) == (uint32_t)expected[i]);
+            assert(i64_rheap_pop_min(heap_p) == expected[i]);
+        }
+        assert(i64_rheap_is_empty(heap_p));
+
+        for (uint32_t i = 0; i < 5; i++) {
+            i64_rheap_push(heap_p, (int64_t)(200 + i), 200 + i);
+        }
+        i64_rheap_clear(heap_p);
+        assert(i64_rheap_is_empty(heap_p));
+        assert(heap_p->last_key == 116);
+
+        for (uint32_t i = 5; i-- > 0;) {
+            i64_rheap_push(heap_p, (int64_t)(300 + i), 300 + i);
+        }
+        for (int64_t i = 0; i < 5; i++) {
+            assert(i64_rheap_pop_min(heap_p) == 300 + i);
+        }
+
+        i64_rheap_destroy(heap_p);
+    }
+    // N = 1e+5, push * 1e+5 -> (pop_min -> push) * 1e+6 -> pop_min * 1e+5
+    {
+        const uint32_t n = (uint32_t)1e+5;
+        struct i64_rheap *heap_p = i64_rheap_create(n);
+        if (!heap_p) {
+            assert(false);
+        }
+        srand(42);
+        for (uint32_t i = 0; i < n; i++) {
+            const uint32_t key = (uint32_t)rand() % 100000;
+            i64_rheap_push(heap_p, (int64_t)key, key);
+        }
+        uint32_t now = 0;
+        for (uint32_t i = 0; i < 1e+6; i++) {
+            const uint32_t key = i64_rheap_get_min_key(heap_p);
+            assert(key >= now);
+            assert(i64_rheap_pop_min(heap_p) == (int64_t)key);
+            now = key;
+
+            const uint32_t next_key = now + (uint32_t)rand() % 100000;
+            i64_rheap_push(heap_p, (int64_t)next_key, next_key);
+        }
+        while (!i64_rheap_is_empty(heap_p)) {
+            const int64_t curr = i64_rheap_pop_min(heap_p);
+            assert(curr >= (int64_t)now);
+            now = (uint32_t)curr;
+        }
+
+        i64_rheap_destroy(heap_p);
+    }
+    // KEY_TYPE = uint64_t, N = 1e+5, push * 1e+5 -> pop_min * 1e+5
+    {
+        const uint32_t n = (uint32_t)1e+5;
+        struct i64_rheap64 *heap_p = i64_rheap64_create(n);
+        if (!heap_p) {
+            assert(false);
+        }
+        srand(42);
+        for (uint32_t i = 0; i < n; i++) {
+            const uint64_t key = ((uint64_t)rand() << 31) | (uint64_t)rand();
+            i64_rheap64_push(heap_p, (int64_t)key, key);
+        }
+        int64_t prev = 0;
+        while (!i64_rheap64_is_empty(heap_p)) {
+            const int64_t curr = i64_rheap64_pop_min(heap_p);
+            assert(prev <= curr);
+            prev = curr;
+        }
+
+        i64_rheap64_destroy(heap_p);
+    }
+}
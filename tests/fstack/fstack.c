@@ -19,8 +19,11 @@
     Mutating operation types:
     - push
     - pop
+    - push_n + pop_n + top_span
     - clear
 
+    VALUE_TYPE := void * is tested for with N := 3, such that `const` is applied to the pointer and not the pointee.
+
     Memory operations [to also be tested with sanitizers]:
     - init (this is indirectly tested for with `create`)
     - create
@@ -32,6 +35,10 @@
 #define VALUE_TYPE int64_t
 #include "fstack.h"
 
+#define NAME       ptr_stk
+#define VALUE_TYPE void *
+#include "fstack.h"
+
 static inline bool check_count_invariance(const struct i64_stk *stk_p, const size_t push_op_count,
                                           const size_t pop_op_count)
 {
@@ -359,4 +366,66 @@ int main(void)
 
         i64_stk_destroy(stk_p);
     }
+    // N = 10, push_n(3) -> push_n(0) -> push_n(7) -> top_span(4) -> pop_n(4) -> pop_n(0) -> pop_n(6)
+    {
+        struct i64_stk *stk_p = i64_stk_create(10);
+        if (!stk_p) {
+            assert(false);
+        }
+        const int64_t values[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+        i64_stk_push_n(stk_p, &values[0], 3);
+        i64_stk_push_n(stk_p, NULL, 0);
+        i64_stk_push_n(stk_p, &values[3], 7);
+        assert(check_empty_full(stk_p, 10, 0));
+        assert(check_top_bottom(stk_p, 9, 0));
+        assert(check_ordered_values(stk_p, 10, (int64_t[10]){9, 8, 7, 6, 5, 4, 3, 2, 1, 0}));
+
+        const int64_t *span = i64_stk_top_span(stk_p, 4);
+        for (uint32_t i = 0; i < 4; i++) {
+            assert(span[i] == 6 + i);
+        }
+
+        int64_t out[10] = {0};
+        i64_stk_pop_n(stk_p, out, 4);
+        for (uint32_t i = 0; i < 4; i++) {
+            assert(out[i] == 6 + i);
+        }
+        i64_stk_pop_n(stk_p, out, 0);
+        assert(check_count_invariance(stk_p, 10, 4));
+        assert(check_top_bottom(stk_p, 5, 0));
+
+        i64_stk_pop_n(stk_p, NULL, 6);
+        assert(i64_stk_is_empty(stk_p));
+
+        i64_stk_destroy(stk_p);
+    }
+    // VALUE_TYPE = void *, N = 3, push -> push_n(2) -> top_span(3) -> pop_n(2) -> pop
+    {
+        struct ptr_stk *stk_p = ptr_stk_create(3);
+        if (!stk_p) {
+            assert(false);
+        }
+        int64_t objects[3] = {0, 1, 2};
+        void *const ptrs[2] = {&objects[1], &objects[2]};
+
+        ptr_stk_push(stk_p, &objects[0]);
+        ptr_stk_push_n(stk_p, ptrs, 2);
+        assert(ptr_stk_is_full(stk_p));
+
+        void *const *span = ptr_stk_top_span(stk_p, 3);
+        for (uint32_t i = 0; i < 3; i++) {
+            assert(span[i] == &objects[i]);
+        }
+
+        void *out[2] = {NULL};
+        ptr_stk_pop_n(stk_p, out, 2);
+        assert(out[0] == &objects[1] && out[1] == &objects[2]);
+
+        int64_t *obj_p = ptr_stk_pop(stk_p);
+        assert(obj_p == &objects[0]);
+        assert(ptr_stk_is_empty(stk_p));
+
+        ptr_stk_destroy(stk_p);
+    }
 }
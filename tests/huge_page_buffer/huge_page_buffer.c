@@ -0,0 +1,78 @@
+/*
+    Test cases:
+    - min_len := 0
+    - min_len := 1
+    - min_len := HUGE_PAGE_SIZE + 1
+    - with and without explicit huge pages
+    - as backing buffer for arena and pool
+
+    Memory operations [to also be tested with sanitizers]:
+    - create
+    - destroy
+
+    Branches:
+    - create()
+        | min_len == 0 -> false
+        | try_explicit && MAP_HUGETLB succeeds -> EXPLICIT
+        | aligned mmap succeeds -> TRANSPARENT / NORMAL
+        | otherwise -> MALLOC
+*/
+
+#include "arena.h"
+#include "huge_page_buffer.h"
+#include "pool.h"
+
+#include <stdint.h>
+
+int main(void)
+{
+    // min_len := 0:
+    {
+        struct huge_page_buffer hpb;
+        assert(!huge_page_buffer_create(&hpb, 0, false));
+    }
+    // min_len := 1 and HUGE_PAGE_SIZE + 1, with and without explicit huge pages:
+    {
+        const size_t lens[] = {1, HUGE_PAGE_SIZE + 1};
+
+        for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+            for (int try_explicit = 0; try_explicit <= 1; try_explicit++) {
+                struct huge_page_buffer hpb;
+                assert(huge_page_buffer_create(&hpb, lens[i], try_explicit));
+
+                assert((uintptr_t)hpb.ptr % HUGE_PAGE_SIZE == 0);
+                assert(hpb.len % HUGE_PAGE_SIZE == 0 && hpb.len >= lens[i] && hpb.len < lens[i] + HUGE_PAGE_SIZE);
+                assert(try_explicit || hpb.kind != HUGE_PAGE_BUFFER_EXPLICIT);
+                assert(hpb.ptr[0] == 0 && hpb.ptr[hpb.len - 1] == 0);
+
+                hpb.ptr[0] = 1;
+                hpb.ptr[hpb.len - 1] = 1;
+
+                huge_page_buffer_destroy(&hpb);
+                assert(hpb.ptr == NULL);
+            }
+        }
+    }
+    // as backing buffer for arena and pool:
+    {
+        struct huge_page_buffer hpb;
+        assert(huge_page_buffer_create(&hpb, 2 * HUGE_PAGE_SIZE, false));
+
+        struct arena a;
+        arena_init(&a, HUGE_PAGE_SIZE, hpb.ptr);
+        int64_t *values = arena_allocate(&a, HUGE_PAGE_SIZE);
+        assert(values == (int64_t *)hpb.ptr);
+        values[HUGE_PAGE_SIZE / sizeof(int64_t) - 1] = 42;
+        assert(!arena_allocate(&a, 1));
+
+        struct pool p;
+        pool_init(&p, HUGE_PAGE_SIZE, &hpb.ptr[HUGE_PAGE_SIZE], 64, 64);
+        size_t count = 0;
+        while (pool_allocate(&p)) {
+            count++;
+        }
+        assert(count == HUGE_PAGE_SIZE / 64);
+
+        huge_page_buffer_destroy(&hpb);
+    }
+}
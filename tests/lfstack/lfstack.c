@@ -0,0 +1,165 @@
+/*
+    Test cases (N):
+    - N := 0
+    - N := 1
+    - N := 2 (tag wraps around)
+    - N := 10
+    - N := 1024 (nodes popped and pushed back by multiple threads)
+
+    Non-mutating operation types / properties:
+    - is_empty
+    - lfstack_node_next
+
+    Mutating operation types:
+    - push
+    - pop
+    - pop_all
+
+    Memory operations [to also be tested with sanitizers]:
+    - init
+*/
+
+#include "container_of.h"
+#include "lfstack.h"
+
+#include <pthread.h>
+#include <stdint.h>
+
+#define THREAD_COUNT          8
+#define ITERATIONS_PER_THREAD 100000
+#define NODE_COUNT            1024
+
+struct object {
+    int64_t value;
+    struct lfstack_node node;
+};
+
+struct thread_arg {
+    struct lfstack *stack_p;
+    uint32_t pop_count;
+};
+
+static void *pop_and_push(void *arg_)
+{
+    struct thread_arg *arg = arg_;
+
+    for (uint32_t i = 0; i < ITERATIONS_PER_THREAD; i++) {
+        struct lfstack_node *node = lfstack_pop(arg->stack_p);
+        if (!node) {
+            continue;
+        }
+        struct object *obj = container_of(node, struct object, node);
+        obj->value++;
+        arg->pop_count++;
+
+        lfstack_push(arg->stack_p, node);
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    // N = 0
+    {
+        struct lfstack stack;
+        lfstack_init(&stack);
+
+        assert(lfstack_is_empty(&stack));
+        assert(lfstack_pop(&stack) == NULL);
+        assert(lfstack_pop_all(&stack) == NULL);
+    }
+    // N = 1, push -> pop
+    {
+        struct lfstack stack;
+        lfstack_init(&stack);
+
+        struct object obj = {.value = 42};
+        lfstack_push(&stack, &obj.node);
+        assert(!lfstack_is_empty(&stack));
+
+        struct lfstack_node *node = lfstack_pop(&stack);
+        assert(node == &obj.node);
+        assert(container_of(node, struct object, node)->value == 42);
+        assert(lfstack_is_empty(&stack));
+    }
+    // N = 2, (push * 2 -> pop * 2) * 2^18, such that the tag wraps around
+    {
+        struct lfstack stack;
+        lfstack_init(&stack);
+
+        struct object objs[2] = {{.value = 0}, {.value = 1}};
+        for (uint32_t i = 0; i < (1U << 18); i++) {
+            lfstack_push(&stack, &objs[0].node);
+            lfstack_push(&stack, &objs[1].node);
+            assert(lfstack_pop(&stack) == &objs[1].node);
+            assert(lfstack_pop(&stack) == &objs[0].node);
+            assert(lfstack_is_empty(&stack));
+        }
+        assert(lfstack_pop(&stack) == NULL);
+    }
+    // N = 10, push * 10 -> pop * 5 -> pop_all
+    {
+        struct lfstack stack;
+        lfstack_init(&stack);
+
+        struct object objs[10];
+        for (int64_t i = 0; i < 10; i++) {
+            objs[i].value = i;
+            lfstack_push(&stack, &objs[i].node);
+        }
+        for (int64_t i = 9; i >= 5; i--) {
+            struct lfstack_node *node = lfstack_pop(&stack);
+            assert(container_of(node, struct object, node)->value == i);
+        }
+
+        int64_t expected = 4;
+        for (struct lfstack_node *node = lfstack_pop_all(&stack); node != NULL; node = lfstack_node_next(node)) {
+            assert(container_of(node, struct object, node)->value == expected);
+            expected--;
+        }
+        assert(expected == -1);
+        assert(lfstack_is_empty(&stack));
+    }
+    // N = 1024, (pop -> push) * 1e+5 by multiple threads
+    {
+        struct lfstack stack;
+        lfstack_init(&stack);
+
+        static struct object objs[NODE_COUNT];
+        for (uint32_t i = 0; i < NODE_COUNT; i++) {
+            objs[i].value = 0;
+            lfstack_push(&stack, &objs[i].node);
+        }
+
+        pthread_t threads[THREAD_COUNT];
+        struct thread_arg args[THREAD_COUNT];
+        for (uint32_t i = 0; i < THREAD_COUNT; i++) {
+            args[i] = (struct thread_arg){.stack_p = &stack, .pop_count = 0};
+            pthread_create(&threads[i], NULL, pop_and_push, &args[i]);
+        }
+
+        int64_t pop_count = 0;
+        for (uint32_t i = 0; i < THREAD_COUNT; i++) {
+            pthread_join(threads[i], NULL);
+            pop_count += args[i].pop_count;
+        }
+
+        /* every node is back in the stack exactly once, and every pop was counted by one node */
+        static bool seen[NODE_COUNT];
+        uint32_t node_count = 0;
+        int64_t value_sum = 0;
+        for (struct lfstack_node *node = lfstack_pop_all(&stack); node != NULL; node = lfstack_node_next(node)) {
+            struct object *obj = container_of(node, struct object, node);
+            const size_t index = (size_t)(obj - objs);
+
+            assert(!seen[index]);
+            seen[index] = true;
+
+            node_count++;
+            value_sum += obj->value;
+        }
+        assert(node_count == NODE_COUNT);
+        assert(value_sum == pop_count);
+        assert(pop_count == (int64_t)THREAD_COUNT * ITERATIONS_PER_THREAD);
+    }
+}
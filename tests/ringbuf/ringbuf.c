@@ -0,0 +1,241 @@
+/*
+    Ring buffer is tested with the SPSC mode enabled, such that the same
+    operations can also be tested from two threads.
+
+    Non-mutating operation types:
+    - is_empty
+    - max_len
+
+    Mutating operation types:
+    - init
+    - reserve + commit / push
+    - read + release
+    - clear
+
+    Branches:
+    - reserve()
+        | len > max_len -> NULL
+        | not enough free space -> NULL
+        | record does not fit before the end -> (padding is written, record starts at index 0)
+        | otherwise -> (pointer to contiguous record data)
+    - commit()
+        | len smaller than reserved -> (record shrinks)
+    - read()
+        | empty -> NULL
+        | padding -> (skips to the record at index 0)
+*/
+
+#define RINGBUF_SPSC
+#include "ringbuf.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+static inline bool check_read_and_release(struct ringbuf *rb, const void *expected_data, const uint32_t expected_len)
+{
+    uint32_t len;
+    const void *ptr = ringbuf_read(rb, &len);
+    if (!ptr) {
+        return false;
+    }
+    const bool res = len == expected_len && memcmp(ptr, expected_data, len) == 0
+                     && (uintptr_t)ptr % RINGBUF_ALIGNMENT == 0;
+    ringbuf_release(rb);
+    return res;
+}
+
+#define SPSC_RECORD_COUNT (1000000U)
+
+static void *spsc_producer(void *arg)
+{
+    struct ringbuf *rb = arg;
+
+    for (uint32_t i = 0; i < SPSC_RECORD_COUNT; i++) {
+        const uint32_t len = 1 + i % 37;
+        unsigned char *ptr;
+        while (!(ptr = ringbuf_reserve(rb, len))) {
+            sched_yield();
+        }
+        memset(ptr, (unsigned char)i, len);
+        ringbuf_commit(rb, len);
+    }
+    return NULL;
+}
+
+static void *spsc_consumer(void *arg)
+{
+    struct ringbuf *rb = arg;
+
+    bool res = true;
+    for (uint32_t i = 0; i < SPSC_RECORD_COUNT; i++) {
+        uint32_t len;
+        const unsigned char *ptr;
+        while (!(ptr = ringbuf_read(rb, &len))) {
+            sched_yield();
+        }
+        res &= len == 1 + i % 37;
+        for (uint32_t j = 0; j < len; j++) {
+            res &= ptr[j] == (unsigned char)i;
+        }
+        ringbuf_release(rb);
+    }
+    return res ? arg : NULL;
+}
+
+int main(void)
+{
+    // empty ring buffer + too large record:
+    {
+        struct ringbuf rb;
+        unsigned char buf[64];
+        ringbuf_init(&rb, sizeof(buf), buf);
+
+        uint32_t len;
+        assert(ringbuf_is_empty(&rb));
+        assert(!ringbuf_read(&rb, &len));
+        assert(ringbuf_max_len(&rb) == rb.capacity / 2 - RINGBUF_HEADER_SIZE);
+        assert(!ringbuf_reserve(&rb, rb.capacity));
+        assert(!ringbuf_reserve(&rb, ringbuf_max_len(&rb) + 1));
+        const unsigned char data[64] = {0};
+        assert(ringbuf_push(&rb, data, ringbuf_max_len(&rb)));
+    }
+    // reserve -> commit -> read -> release:
+    {
+        struct ringbuf rb;
+        unsigned char buf[64];
+        ringbuf_init(&rb, sizeof(buf), buf);
+
+        char *ptr = ringbuf_reserve(&rb, 5);
+        assert(ptr);
+        memcpy(ptr, "hello", 5);
+        assert(ringbuf_is_empty(&rb));
+        ringbuf_commit(&rb, 5);
+        assert(!ringbuf_is_empty(&rb));
+
+        assert(ringbuf_push(&rb, "hi", 2));
+        assert(ringbuf_push(&rb, "", 0));
+
+        assert(check_read_and_release(&rb, "hello", 5));
+        assert(check_read_and_release(&rb, "hi", 2));
+        assert(check_read_and_release(&rb, "", 0));
+        assert(ringbuf_is_empty(&rb));
+    }
+    // commit fewer bytes than reserved:
+    {
+        struct ringbuf rb;
+        unsigned char buf[64];
+        ringbuf_init(&rb, sizeof(buf), buf);
+
+        char *ptr = ringbuf_reserve(&rb, 24);
+        assert(ptr);
+        memcpy(ptr, "abc", 3);
+        ringbuf_commit(&rb, 3);
+
+        assert(ringbuf_push(&rb, "012345678901234567890123", 24));
+        assert(check_read_and_release(&rb, "abc", 3));
+        assert(check_read_and_release(&rb, "012345678901234567890123", 24));
+    }
+    // full ring buffer:
+    {
+        struct ringbuf rb;
+        unsigned char buf[64];
+        ringbuf_init(&rb, sizeof(buf), buf);
+
+        assert(ringbuf_push(&rb, "aaaaaaaa", 8));
+        assert(ringbuf_push(&rb, "bbbbbbbb", 8));
+        assert(ringbuf_push(&rb, "cccccccc", 8));
+        assert(ringbuf_push(&rb, "dddddddd", 8));
+        assert(!ringbuf_reserve(&rb, 1));
+        assert(!ringbuf_push(&rb, "e", 0));
+
+        assert(check_read_and_release(&rb, "aaaaaaaa", 8));
+        assert(ringbuf_push(&rb, "eeeeeeee", 8));
+        assert(check_read_and_release(&rb, "bbbbbbbb", 8));
+        assert(check_read_and_release(&rb, "cccccccc", 8));
+        assert(check_read_and_release(&rb, "dddddddd", 8));
+        assert(check_read_and_release(&rb, "eeeeeeee", 8));
+        assert(ringbuf_is_empty(&rb));
+    }
+    // record does not fit before the end -> padding:
+    {
+        struct ringbuf rb;
+        unsigned char buf[64];
+        ringbuf_init(&rb, sizeof(buf), buf);
+
+        assert(ringbuf_push(&rb, "0123456789012345", 16)); // [0, 24)
+        assert(ringbuf_push(&rb, "0123456789012345", 16)); // [24, 48)
+        assert(check_read_and_release(&rb, "0123456789012345", 16));
+
+        // 16 bytes left till the end and 24 bytes free at the front, but the record needs 16 + 32 bytes:
+        assert(!ringbuf_push(&rb, "abcdefghijklmnopqrst", 20));
+
+        assert(ringbuf_push(&rb, "abcdefghijkl", 12)); // padding [48, 64), record [0, 24)
+        assert(check_read_and_release(&rb, "0123456789012345", 16));
+        assert(check_read_and_release(&rb, "abcdefghijkl", 12));
+        assert(ringbuf_is_empty(&rb));
+    }
+    // record of max_len wraps into an empty ring buffer at every offset:
+    {
+        struct ringbuf rb;
+        unsigned char buf[256];
+        ringbuf_init(&rb, sizeof(buf), buf);
+
+        unsigned char data[256];
+        for (size_t i = 0; i < sizeof(data); i++) {
+            data[i] = (unsigned char)i;
+        }
+
+        assert(ringbuf_push(&rb, data, 120));
+        assert(check_read_and_release(&rb, data, 120));
+        assert(ringbuf_is_empty(&rb));
+        assert(ringbuf_push(&rb, data, 120)); // padding [128, 256), record [0, 128)
+        assert(check_read_and_release(&rb, data, 120));
+
+        for (uint32_t len = 0; len <= ringbuf_max_len(&rb); len++) {
+            assert(ringbuf_is_empty(&rb));
+            assert(ringbuf_push(&rb, data, len));
+            assert(check_read_and_release(&rb, data, len));
+            assert(ringbuf_push(&rb, data, ringbuf_max_len(&rb)));
+            assert(check_read_and_release(&rb, data, ringbuf_max_len(&rb)));
+        }
+    }
+    // clear:
+    {
+        struct ringbuf rb;
+        unsigned char buf[64];
+        ringbuf_init(&rb, sizeof(buf), buf);
+
+        assert(ringbuf_push(&rb, "abc", 3));
+        ringbuf_clear(&rb);
+        assert(ringbuf_is_empty(&rb));
+        assert(ringbuf_push(&rb, "def", 3));
+        assert(check_read_and_release(&rb, "def", 3));
+    }
+    // initialize with unaligned buffer:
+    {
+        struct ringbuf rb;
+        unsigned char buf[1 + RINGBUF_ALIGNMENT + 64];
+        ringbuf_init(&rb, sizeof(buf) - 1, &buf[1]);
+
+        assert(rb.capacity == 64);
+        assert(ringbuf_push(&rb, "abc", 3));
+        assert(check_read_and_release(&rb, "abc", 3));
+    }
+    // single producer, single consumer:
+    {
+        struct ringbuf rb;
+        static unsigned char buf[1024];
+        ringbuf_init(&rb, sizeof(buf), buf);
+
+        pthread_t producer, consumer;
+        pthread_create(&producer, NULL, spsc_producer, &rb);
+        pthread_create(&consumer, NULL, spsc_consumer, &rb);
+
+        void *res;
+        pthread_join(producer, NULL);
+        pthread_join(consumer, &res);
+
+        assert(res == &rb);
+        assert(ringbuf_is_empty(&rb));
+    }
+}
@@ -0,0 +1,135 @@
+/*
+    Test cases:
+    - no conflicts
+    - the caller's arena is a scratch arena (one conflict)
+    - nested scratch regions in the same arena
+    - multiple threads
+
+    Mutating operation types:
+    - scratch_begin
+    - scratch_end
+    - scratch_arena_release_thread
+
+    Branches:
+    - scratch_begin()
+        | arena is not created yet -> (create it with reserved virtual memory or malloc)
+        | otherwise -> (saved state of the first scratch arena not in conflicts)
+*/
+
+#include "scratch_arena.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+
+#define THREAD_COUNT 4
+
+/* computes the sum of 0..n-1 into out_arena, using scratch memory for the temporaries */
+static int64_t *sum_range(struct arena *out_arena, const int64_t n)
+{
+    struct temp_arena_state scratch = scratch_begin(&out_arena, 1);
+    assert(scratch.arena_ptr != NULL && scratch.arena_ptr != out_arena);
+
+    int64_t *tmp = arena_allocate(scratch.arena_ptr, (size_t)n * sizeof(int64_t));
+    assert(tmp);
+    for (int64_t i = 0; i < n; i++) {
+        tmp[i] = i;
+    }
+
+    int64_t *result = arena_allocate(out_arena, sizeof(int64_t));
+    assert(result);
+    *result = 0;
+    for (int64_t i = 0; i < n; i++) {
+        *result += tmp[i];
+    }
+
+    scratch_end(scratch);
+
+    return result;
+}
+
+static void *thread_fn(void *arg)
+{
+    struct temp_arena_state scratch = scratch_begin(NULL, 0);
+    assert(scratch.arena_ptr != NULL);
+
+    struct arena **arena_pp = arg;
+    *arena_pp = scratch.arena_ptr;
+
+    int64_t *result = sum_range(scratch.arena_ptr, 1000);
+    assert(*result == 999 * 1000 / 2);
+
+    scratch_end(scratch);
+    scratch_arena_release_thread();
+
+    return NULL;
+}
+
+int main(void)
+{
+    // no conflicts and nested regions:
+    {
+        struct temp_arena_state outer = scratch_begin(NULL, 0);
+        assert(outer.arena_ptr != NULL);
+
+        unsigned char *p1 = arena_allocate(outer.arena_ptr, 100);
+        assert(p1);
+        memset(p1, 'a', 100);
+
+        struct temp_arena_state inner = scratch_begin(NULL, 0);
+        assert(inner.arena_ptr == outer.arena_ptr);
+
+        unsigned char *p2 = arena_allocate(inner.arena_ptr, 100);
+        assert(p2 && p2 != p1);
+        scratch_end(inner);
+
+        assert(arena_allocate(outer.arena_ptr, 100) == p2);
+        assert(p1[99] == 'a');
+
+        scratch_end(outer);
+        assert(arena_allocate(outer.arena_ptr, 100) == p1);
+        scratch_end(outer);
+    }
+    // the caller's arena is a scratch arena:
+    {
+        struct temp_arena_state scratch = scratch_begin(NULL, 0);
+        struct arena *out_arena = scratch.arena_ptr;
+
+        int64_t *result1 = sum_range(out_arena, 10);
+        int64_t *result2 = sum_range(out_arena, 100000);
+
+        assert(*result1 == 9 * 10 / 2);
+        assert(*result2 == (int64_t)99999 * 100000 / 2);
+
+        scratch_end(scratch);
+    }
+    // multiple threads get their own arenas:
+    {
+        pthread_t threads[THREAD_COUNT];
+        struct arena *arenas[THREAD_COUNT];
+
+        for (size_t i = 0; i < THREAD_COUNT; i++) {
+            pthread_create(&threads[i], NULL, thread_fn, &arenas[i]);
+        }
+        for (size_t i = 0; i < THREAD_COUNT; i++) {
+            pthread_join(threads[i], NULL);
+        }
+
+        struct temp_arena_state scratch = scratch_begin(NULL, 0);
+        for (size_t i = 0; i < THREAD_COUNT; i++) {
+            assert(arenas[i] != scratch.arena_ptr);
+        }
+        scratch_end(scratch);
+    }
+    // release:
+    {
+        scratch_arena_release_thread();
+
+        struct temp_arena_state scratch = scratch_begin(NULL, 0);
+        assert(scratch.arena_ptr != NULL);
+        assert(arena_allocate(scratch.arena_ptr, 1) != NULL);
+        scratch_end(scratch);
+
+        scratch_arena_release_thread();
+    }
+}
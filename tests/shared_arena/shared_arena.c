@@ -0,0 +1,159 @@
+/*
+    Shared arena struct should be opaque if the library is made non-header-only. So the struct members are not tested.
+
+    Mutating operation types:
+    - init
+    - deallocate_all
+    - allocate_aligned / allocate (+ _uninit) [to be tested by multiple threads]
+    - init_local
+    - local_allocate_aligned / local_allocate [to be tested by multiple threads]
+
+    Branches:
+    - allocate_aligned()
+        | request > buf_len -> NULL
+        | offset > buf_len - request -> NULL
+        | otherwise -> (non-NULL pointer to chunk of memory with correct alignment, not overlapping other chunks)
+    - local_allocate_aligned()
+        | local arena has space -> (chunk from the local arena)
+        | init_local fails -> NULL
+        | otherwise -> (chunk from a newly carved local arena)
+*/
+
+#include "shared_arena.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define THREAD_COUNT 8
+#define BUF_LEN      ((size_t)1 << 20)
+#define MAX_CHUNKS   (BUF_LEN / alignof(max_align_t))
+
+struct chunk {
+    unsigned char *ptr;
+    size_t size;
+};
+
+struct thread_arg {
+    struct shared_arena *shared_arena_p;
+    bool use_local;
+    unsigned char id;
+    size_t count;
+    size_t bytes;
+    struct chunk *chunks;
+};
+
+static void *allocate_until_full(void *arg_)
+{
+    struct thread_arg *arg = arg_;
+    struct arena local = {0};
+
+    for (size_t i = 0;; i++) {
+        const size_t alignment = (size_t)1 << (i % 8);
+        const size_t size = 1 + (i * 7) % 100;
+
+        unsigned char *ptr = arg->use_local
+                                 ? shared_arena_local_allocate_aligned(arg->shared_arena_p, &local, alignment, size)
+                                 : shared_arena_allocate_aligned(arg->shared_arena_p, alignment, size);
+        if (!ptr) {
+            break;
+        }
+        assert((uintptr_t)ptr % alignment == 0);
+        for (size_t j = 0; j < size; j++) {
+            assert(ptr[j] == 0);
+        }
+        memset(ptr, arg->id, size);
+
+        arg->chunks[arg->count++] = (struct chunk){.ptr = ptr, .size = size};
+        arg->bytes += size;
+    }
+    return NULL;
+}
+
+static void run_threads(struct shared_arena *shared_arena_p, const bool use_local)
+{
+    pthread_t threads[THREAD_COUNT];
+    struct thread_arg args[THREAD_COUNT];
+
+    for (unsigned char i = 0; i < THREAD_COUNT; i++) {
+        args[i] = (struct thread_arg){.shared_arena_p = shared_arena_p,
+                                      .use_local = use_local,
+                                      .id = (unsigned char)(i + 1),
+                                      .count = 0,
+                                      .bytes = 0,
+                                      .chunks = malloc(MAX_CHUNKS * sizeof(struct chunk))};
+        assert(args[i].chunks);
+        pthread_create(&threads[i], NULL, allocate_until_full, &args[i]);
+    }
+    size_t total_bytes = 0;
+    for (size_t i = 0; i < THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+        total_bytes += args[i].bytes;
+    }
+    assert(total_bytes <= BUF_LEN);
+    assert(total_bytes >= BUF_LEN / 4);
+
+    // no chunk has been overwritten by another thread:
+    for (size_t i = 0; i < THREAD_COUNT; i++) {
+        for (size_t j = 0; j < args[i].count; j++) {
+            for (size_t k = 0; k < args[i].chunks[j].size; k++) {
+                assert(args[i].chunks[j].ptr[k] == args[i].id);
+            }
+        }
+        free(args[i].chunks);
+    }
+}
+
+int main(void)
+{
+    unsigned char *buf = calloc(1, BUF_LEN);
+    assert(buf);
+
+    // single-threaded:
+    {
+        struct shared_arena sa;
+        alignas(2 * alignof(max_align_t)) unsigned char small_buf[4 * alignof(max_align_t)];
+        shared_arena_init(&sa, sizeof(small_buf), small_buf);
+
+        assert(!shared_arena_allocate(&sa, sizeof(small_buf) + 1));
+        assert(!shared_arena_allocate(&sa, SIZE_MAX));
+        assert(!shared_arena_allocate_aligned(&sa, 8 * alignof(max_align_t), 1));
+
+        unsigned char *p1 = shared_arena_allocate_aligned(&sa, 1, 1);
+        unsigned char *p2 = shared_arena_allocate_uninit(&sa, 1);
+        unsigned char *p3 = shared_arena_allocate_aligned_uninit(&sa, 2 * alignof(max_align_t), 1);
+        assert(p1 == &small_buf[0]);
+        assert(p2 == &small_buf[alignof(max_align_t)]);
+        assert(p3 == &small_buf[2 * alignof(max_align_t)]);
+        assert(!shared_arena_allocate(&sa, 1));
+        assert(!shared_arena_allocate(&sa, 1));
+
+        shared_arena_deallocate_all(&sa);
+        assert(shared_arena_allocate(&sa, 1) == &small_buf[0]);
+
+        struct arena local;
+        assert(!shared_arena_init_local(&sa, &local, sizeof(small_buf)));
+        assert(shared_arena_init_local(&sa, &local, 2 * alignof(max_align_t)));
+        assert(arena_allocate(&local, 1) == &small_buf[alignof(max_align_t)]);
+        assert(arena_allocate(&local, 1) == &small_buf[2 * alignof(max_align_t)]);
+        assert(!arena_allocate(&local, 1));
+    }
+    // multiple threads allocating from the shared arena:
+    {
+        struct shared_arena sa;
+        shared_arena_init(&sa, BUF_LEN, buf);
+
+        run_threads(&sa, false);
+    }
+    // multiple threads allocating from local arenas:
+    {
+        memset(buf, 0, BUF_LEN);
+
+        struct shared_arena sa;
+        shared_arena_init(&sa, BUF_LEN, buf);
+
+        run_threads(&sa, true);
+    }
+
+    free(buf);
+}
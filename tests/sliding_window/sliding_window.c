@@ -0,0 +1,144 @@
+/*
+    Test cases (window size W, N values pushed):
+    - W := 0
+    - W := 1, N := 10
+    - W := 3, N := 10
+    - W := 100, N := 1e+5 (random values, compared against recomputing the aggregates)
+
+    Non-mutating operation types:
+    - count
+    - is_empty
+    - is_full
+    - sum
+    - mean
+    - variance
+    - min
+    - max
+
+    Mutating operation types:
+    - push (with and without eviction)
+    - pop
+    - clear
+
+    Memory operations [to also be tested with sanitizers]:
+    - create
+    - destroy
+*/
+
+#include "sliding_window.h"
+
+static inline bool double_is_nearly_equal(const double a, const double b, const double tolerance)
+{
+    return fabs(a - b) <= tolerance * (1. + fabs(b));
+}
+
+static inline bool check_aggregates(const struct sliding_window *w, const size_t n, const double values[n])
+{
+    if (n == 0) {
+        return sliding_window_is_empty(w) && sliding_window_sum(w) == 0.;
+    }
+
+    double sum = 0., min = values[0], max = values[0];
+    for (size_t i = 0; i < n; i++) {
+        sum += values[i];
+        min = values[i] < min ? values[i] : min;
+        max = values[i] > max ? values[i] : max;
+    }
+    const double mean = sum / (double)n;
+
+    double variance = 0.;
+    for (size_t i = 0; i < n; i++) {
+        variance += (values[i] - mean) * (values[i] - mean);
+    }
+    variance /= (double)n;
+
+    bool res = sliding_window_count(w) == n;
+    res &= double_is_nearly_equal(sliding_window_sum(w), sum, 1e-12);
+    res &= double_is_nearly_equal(sliding_window_mean(w), mean, 1e-12);
+    res &= double_is_nearly_equal(sliding_window_variance(w), variance, 1e-9);
+    res &= sliding_window_min(w) == min;
+    res &= sliding_window_max(w) == max;
+    return res;
+}
+
+int main(void)
+{
+    // W = 0
+    {
+        struct sliding_window *w = sliding_window_create(0);
+        if (w) {
+            assert(false);
+        }
+    }
+    // W = 1, N = 10
+    {
+        struct sliding_window *w = sliding_window_create(1);
+        if (!w) {
+            assert(false);
+        }
+        assert(sliding_window_is_empty(w));
+        assert(check_aggregates(w, 0, NULL));
+
+        for (size_t i = 0; i < 10; i++) {
+            sliding_window_push(w, (double)i);
+            assert(sliding_window_is_full(w));
+            assert(check_aggregates(w, 1, (double[1]){(double)i}));
+        }
+        assert(sliding_window_pop(w) == 9.);
+        assert(check_aggregates(w, 0, NULL));
+
+        sliding_window_destroy(w);
+    }
+    // W = 3, N = 10
+    {
+        struct sliding_window *w = sliding_window_create(3);
+        if (!w) {
+            assert(false);
+        }
+        const double values[10] = {5., 1., 4., 4., 2., 8., 8., 3., 1., 9.};
+
+        sliding_window_push(w, values[0]);
+        assert(check_aggregates(w, 1, &values[0]));
+        sliding_window_push(w, values[1]);
+        assert(check_aggregates(w, 2, &values[0]));
+        assert(!sliding_window_is_full(w));
+
+        for (size_t i = 2; i < 10; i++) {
+            sliding_window_push(w, values[i]);
+            assert(sliding_window_is_full(w));
+            assert(check_aggregates(w, 3, &values[i - 2]));
+        }
+
+        assert(sliding_window_pop(w) == 3.);
+        assert(check_aggregates(w, 2, &values[8]));
+
+        sliding_window_clear(w);
+        assert(check_aggregates(w, 0, NULL));
+        sliding_window_push(w, 42.);
+        assert(check_aggregates(w, 1, (double[1]){42.}));
+
+        sliding_window_destroy(w);
+    }
+    // W = 100, N = 1e+5
+    {
+        struct sliding_window *w = sliding_window_create(100);
+        if (!w) {
+            assert(false);
+        }
+        static double values[100000];
+
+        srand(42);
+        for (size_t i = 0; i < 100000; i++) {
+            values[i] = 1e+6 + (double)(rand() % 10000) / 100.;
+            sliding_window_push(w, values[i]);
+
+            if (i % 997 == 0) {
+                const size_t n = i + 1 < 100 ? i + 1 : 100;
+                assert(check_aggregates(w, n, &values[i + 1 - n]));
+            }
+        }
+        assert(check_aggregates(w, 100, &values[100000 - 100]));
+
+        sliding_window_destroy(w);
+    }
+}
@@ -0,0 +1,197 @@
+/*
+    Test cases (N):
+    - N := 0
+    - N := 1
+    - N := 10
+    - N := 1e+6
+
+    Non-mutating operation types / properties:
+    - .count
+    - .capacity
+    - is_empty
+    - is_full
+    - get_top / peek
+    - get_bottom
+    - at + stack_for_each + stack_for_each_reverse + fstack_for_each
+
+    Mutating operation types:
+    - push (grows the stack when full)
+    - pop
+    - reserve (this is indirectly tested for with pushes on a full stack)
+    - clear
+
+    Memory operations [to also be tested with sanitizers]:
+    - create
+    - create_with_arena
+    - destroy
+    - copy
+*/
+
+/* for fstack_for_each */
+#define NAME       i64_fstk
+#define VALUE_TYPE int64_t
+#include "fstack.h"
+
+#define NAME       i64_stk
+#define VALUE_TYPE int64_t
+#include "stack.h"
+
+static inline bool check_ordered_values(const struct i64_stk *stk_p, const size_t n, const int64_t expected_value[n])
+{
+    bool res = stk_p->count == n;
+    for (size_t i = 0; i < n; i++) {
+        res &= i64_stk_at(stk_p, (uint32_t)i) == expected_value[n - 1 - i];
+    }
+    {
+        size_t index = n;
+        int64_t value;
+
+        uint32_t tempi;
+        stack_for_each(stk_p, tempi, value)
+        {
+            res &= value == expected_value[--index];
+        }
+        assert(index == 0);
+    }
+    {
+        size_t index = 0;
+        int64_t value;
+
+        uint32_t tempi;
+        stack_for_each_reverse(stk_p, tempi, value)
+        {
+            res &= value == expected_value[index++];
+        }
+        assert(index == n);
+    }
+    {
+        size_t index = n;
+        int64_t value;
+
+        uint32_t tempi;
+        fstack_for_each(stk_p, tempi, value)
+        {
+            res &= value == expected_value[--index];
+        }
+        assert(index == 0);
+    }
+    return res;
+}
+
+int main(void)
+{
+    // N = 0
+    {
+        struct i64_stk *stk_p = i64_stk_create(0);
+        if (stk_p) {
+            assert(false);
+        }
+    }
+    // N = 1, push * 10 -> pop * 10
+    {
+        struct i64_stk *stk_p = i64_stk_create(1);
+        if (!stk_p) {
+            assert(false);
+        }
+        assert(i64_stk_is_empty(stk_p));
+        assert(stk_p->capacity == 1);
+
+        const int64_t expected_value[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+        for (uint32_t i = 0; i < 10; i++) {
+            assert(i64_stk_push(stk_p, expected_value[i]));
+            assert(i64_stk_get_top(stk_p) == expected_value[i]);
+            assert(i64_stk_get_bottom(stk_p) == 0);
+        }
+        assert(stk_p->capacity == 16);
+        assert(check_ordered_values(stk_p, 10, expected_value));
+
+        for (int64_t i = 9; i >= 0; i--) {
+            assert(i64_stk_peek(stk_p) == i);
+            assert(i64_stk_pop(stk_p) == i);
+        }
+        assert(i64_stk_is_empty(stk_p));
+
+        i64_stk_destroy(stk_p);
+    }
+    // N = 10, push * 10 -> copy -> clear -> push * 5
+    {
+        struct i64_stk *stk_p = i64_stk_create(10);
+        struct i64_stk *stk_copy_p = i64_stk_create(1);
+        if (!stk_p || !stk_copy_p) {
+            assert(false);
+        }
+        for (uint32_t i = 0; i < 10; i++) {
+            assert(i64_stk_push(stk_p, (int64_t)i));
+        }
+        assert(i64_stk_is_full(stk_p));
+
+        assert(i64_stk_copy(stk_copy_p, stk_p));
+        {
+            const int64_t expected_value[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+            assert(check_ordered_values(stk_copy_p, 10, expected_value));
+        }
+
+        i64_stk_clear(stk_p);
+        assert(i64_stk_is_empty(stk_p));
+        assert(stk_p->capacity == 10);
+
+        for (uint32_t i = 0; i < 5; i++) {
+            assert(i64_stk_push(stk_p, (int64_t)(i + 10)));
+        }
+        {
+            const int64_t expected_value[5] = {10, 11, 12, 13, 14};
+            assert(check_ordered_values(stk_p, 5, expected_value));
+        }
+
+        i64_stk_destroy(stk_copy_p);
+        i64_stk_destroy(stk_p);
+    }
+    // N = 1e+6, push * 1e+6 -> pop * 1e+6
+    {
+        struct i64_stk *stk_p = i64_stk_create(1);
+        if (!stk_p) {
+            assert(false);
+        }
+        for (int64_t i = 0; i < 1e+6; i++) {
+            assert(i64_stk_push(stk_p, i));
+        }
+        assert(stk_p->count == 1e+6);
+        for (int64_t i = (int64_t)1e+6 - 1; i >= 0; i--) {
+            assert(i64_stk_pop(stk_p) == i);
+        }
+
+        i64_stk_destroy(stk_p);
+    }
+    // arena, N = 1e+3, push * 1e+3 -> pop * 1e+3
+    {
+        static unsigned char buf[1 << 14];
+        struct arena arena;
+        arena_init(&arena, sizeof(buf), buf);
+
+        struct i64_stk *stk_p = i64_stk_create_with_arena(&arena, 1);
+        if (!stk_p) {
+            assert(false);
+        }
+        const int64_t *values_before = stk_p->values;
+
+        for (int64_t i = 0; i < 1e+3; i++) {
+            assert(i64_stk_push(stk_p, i));
+        }
+        /* the values are the last allocation in the arena, so they are grown in place */
+        assert(stk_p->values == values_before);
+        assert(stk_p->capacity == 1024);
+
+        /* growing past the end of the arena fails, and the stack is kept as is */
+        for (int64_t i = 1e+3; i < 1024; i++) {
+            assert(i64_stk_push(stk_p, i));
+        }
+        assert(!i64_stk_push(stk_p, 1024));
+        assert(stk_p->count == 1024);
+
+        for (int64_t i = 1023; i >= 0; i--) {
+            assert(i64_stk_pop(stk_p) == i);
+        }
+
+        i64_stk_destroy(stk_p);
+    }
+}
@@ -0,0 +1,231 @@
+/*
+    Test cases:
+    - no timers
+    - one timer (level 0, higher levels, out of range, in the past)
+    - cancel
+    - same tick
+    - expired timers removed from the expired list instead of cancelled
+    - 1e+5 random timers with random cancellations
+
+    Non-mutating operation types / properties:
+    - .now
+    - .count
+    - timer_is_scheduled
+
+    Mutating operation types:
+    - timer_init
+    - init
+    - schedule
+    - cancel
+    - advance
+*/
+
+#include "timing_wheel.h"
+
+#include <stdlib.h>
+
+struct connection {
+    uint32_t id;
+    struct timing_wheel_timer timeout;
+};
+
+static inline struct connection *pop_expired(struct list_node *expired_head)
+{
+    if (expired_head->next_ptr == expired_head) {
+        return NULL;
+    }
+    struct list_node *node = list_node_remove(expired_head->next_ptr);
+    struct timing_wheel_timer *timer = list_node_entry(node, struct timing_wheel_timer, node);
+
+    return container_of(timer, struct connection, timeout);
+}
+
+/* schedule a single timer at a given tick and check that it expires exactly then */
+static inline bool check_single_timer(const uint64_t now, const uint64_t expires)
+{
+    struct timing_wheel wheel;
+    struct connection conn = {.id = 1};
+    struct list_node expired;
+
+    timing_wheel_init(&wheel, now);
+    timing_wheel_timer_init(&conn.timeout);
+    list_node_init(&expired);
+
+    timing_wheel_schedule(&wheel, &conn.timeout, expires);
+
+    const uint64_t expected = expires > now ? expires : now + 1;
+
+    bool res = wheel.count == 1;
+    res &= timing_wheel_advance(&wheel, expected - 1, &expired) == 0;
+    res &= timing_wheel_timer_is_scheduled(&conn.timeout);
+    res &= timing_wheel_advance(&wheel, expected, &expired) == 1;
+    res &= pop_expired(&expired) == &conn;
+    res &= pop_expired(&expired) == NULL;
+    res &= !timing_wheel_timer_is_scheduled(&conn.timeout);
+    res &= wheel.count == 0;
+    res &= wheel.now == expected;
+
+    return res;
+}
+
+int main(void)
+{
+    // no timers
+    {
+        struct timing_wheel wheel;
+        struct list_node expired;
+        timing_wheel_init(&wheel, 42);
+        list_node_init(&expired);
+
+        assert(wheel.now == 42);
+        assert(wheel.count == 0);
+        assert(timing_wheel_advance(&wheel, 1000000000, &expired) == 0);
+        assert(wheel.now == 1000000000);
+        assert(pop_expired(&expired) == NULL);
+    }
+    // one timer
+    {
+        assert(check_single_timer(0, 1));
+        assert(check_single_timer(0, 63));
+        assert(check_single_timer(0, 64));
+        assert(check_single_timer(10, 75));
+        assert(check_single_timer(63, 64));
+        assert(check_single_timer(100, 4095));
+        assert(check_single_timer(100, 4096 + 100));
+        assert(check_single_timer(4000, 300000));
+        assert(check_single_timer(12345, 12345 + (1 << 24) - 1));
+        assert(check_single_timer(12345, 12345 + (1 << 24)));
+        assert(check_single_timer(7, 7 + 3 * (1 << 24) + 5));
+        assert(check_single_timer(100, 100));
+        assert(check_single_timer(100, 50));
+    }
+    // cancel
+    {
+        struct timing_wheel wheel;
+        struct connection conns[3] = {{.id = 0}, {.id = 1}, {.id = 2}};
+        struct list_node expired;
+
+        timing_wheel_init(&wheel, 0);
+        list_node_init(&expired);
+        for (uint32_t i = 0; i < 3; i++) {
+            timing_wheel_timer_init(&conns[i].timeout);
+            timing_wheel_schedule(&wheel, &conns[i].timeout, 100 * (i + 1));
+        }
+        assert(wheel.count == 3);
+
+        timing_wheel_cancel(&wheel, &conns[1].timeout);
+        assert(!timing_wheel_timer_is_scheduled(&conns[1].timeout));
+        assert(wheel.count == 2);
+
+        timing_wheel_schedule(&wheel, &conns[1].timeout, 400);
+
+        assert(timing_wheel_advance(&wheel, 1000, &expired) == 3);
+        assert(pop_expired(&expired)->id == 0);
+        assert(pop_expired(&expired)->id == 2);
+        assert(pop_expired(&expired)->id == 1);
+        assert(pop_expired(&expired) == NULL);
+    }
+    // same tick
+    {
+        struct timing_wheel wheel;
+        struct connection conns[4] = {{.id = 0}, {.id = 1}, {.id = 2}, {.id = 3}};
+        struct list_node expired;
+
+        timing_wheel_init(&wheel, 0);
+        list_node_init(&expired);
+        for (uint32_t i = 0; i < 3; i++) {
+            timing_wheel_timer_init(&conns[i].timeout);
+            timing_wheel_schedule(&wheel, &conns[i].timeout, 5000);
+        }
+        /* scheduled directly at level 0, before the others are cascaded into the same slot */
+        assert(timing_wheel_advance(&wheel, 4990, &expired) == 0);
+        timing_wheel_timer_init(&conns[3].timeout);
+        timing_wheel_schedule(&wheel, &conns[3].timeout, 5000);
+
+        assert(timing_wheel_advance(&wheel, 5000, &expired) == 4);
+        bool seen[4] = {false};
+        for (uint32_t i = 0; i < 4; i++) {
+            struct connection *conn = pop_expired(&expired);
+            assert(conn->timeout.expires == 5000);
+            assert(!seen[conn->id]);
+            seen[conn->id] = true;
+        }
+        assert(pop_expired(&expired) == NULL);
+    }
+    // expired timers removed from the expired list instead of cancelled
+    {
+        struct timing_wheel wheel;
+        struct connection conns[2] = {{.id = 0}, {.id = 1}};
+        struct list_node expired;
+
+        timing_wheel_init(&wheel, 0);
+        list_node_init(&expired);
+        for (uint32_t i = 0; i < 2; i++) {
+            timing_wheel_timer_init(&conns[i].timeout);
+            timing_wheel_schedule(&wheel, &conns[i].timeout, 10 * (i + 1));
+        }
+        assert(timing_wheel_advance(&wheel, 10, &expired) == 1);
+        assert(wheel.count == 1);
+        assert(timing_wheel_timer_is_scheduled(&conns[0].timeout));
+
+        list_node_remove(&conns[0].timeout.node);
+        assert(!timing_wheel_timer_is_scheduled(&conns[0].timeout));
+        assert(wheel.count == 1);
+
+        timing_wheel_cancel(&wheel, &conns[1].timeout);
+        assert(wheel.count == 0);
+
+        timing_wheel_schedule(&wheel, &conns[0].timeout, 30);
+        assert(wheel.count == 1);
+        assert(timing_wheel_advance(&wheel, 30, &expired) == 1);
+        assert(pop_expired(&expired) == &conns[0]);
+        assert(wheel.count == 0);
+    }
+    // 1e+5 random timers with random cancellations
+    {
+        const uint32_t n = (uint32_t)1e+5;
+        struct connection *conns = malloc(n * sizeof(struct connection));
+        bool *cancelled = calloc(n, sizeof(bool));
+        if (!conns || !cancelled) {
+            assert(false);
+        }
+
+        struct timing_wheel wheel;
+        struct list_node expired;
+        timing_wheel_init(&wheel, 1000);
+        list_node_init(&expired);
+
+        srand(42);
+        for (uint32_t i = 0; i < n; i++) {
+            conns[i].id = i;
+            timing_wheel_timer_init(&conns[i].timeout);
+            timing_wheel_schedule(&wheel, &conns[i].timeout, 1000 + (uint64_t)rand() % 1000000);
+        }
+        for (uint32_t i = 0; i < n; i += 3) {
+            timing_wheel_cancel(&wheel, &conns[i].timeout);
+            cancelled[i] = true;
+        }
+
+        uint32_t expired_count = 0;
+        uint64_t now = 1000;
+        while (wheel.count > 0) {
+            const uint64_t prev_now = now;
+            now += (uint64_t)rand() % 5000;
+            expired_count += timing_wheel_advance(&wheel, now, &expired);
+
+            uint64_t prev = 0;
+            struct connection *conn;
+            while ((conn = pop_expired(&expired))) {
+                assert(!cancelled[conn->id]);
+                assert(conn->timeout.expires <= now);
+                assert(conn->timeout.expires > prev_now);
+                assert(conn->timeout.expires >= prev);
+                prev = conn->timeout.expires;
+            }
+        }
+        assert(expired_count == n - (n + 2) / 3);
+
+        free(cancelled);
+        free(conns);
+    }
+}
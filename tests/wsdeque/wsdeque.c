@@ -0,0 +1,171 @@
+/*
+    Test cases (N):
+    - N := 0
+    - N := 1
+    - N := 10 (with growth and wrap-around)
+    - N := 1e+6 (values pushed / popped by the owner and stolen by other threads)
+
+    Non-mutating operation types / properties:
+    - count
+    - is_empty
+
+    Mutating operation types:
+    - push (grows the deque when full)
+    - pop
+    - steal
+
+    Memory operations [to also be tested with sanitizers]:
+    - create
+    - destroy
+*/
+
+#define NAME       u64_wsdeque
+#define VALUE_TYPE uint64_t
+#include "wsdeque.h"
+
+#include <pthread.h>
+
+#define THIEF_COUNT 4
+#define VALUE_COUNT 1000000
+
+static _Atomic bool owner_done;
+static uint8_t taken[VALUE_COUNT];
+
+struct thread_arg {
+    struct u64_wsdeque *deq_p;
+    uint64_t sum;
+    uint64_t count;
+};
+
+static void *thief(void *arg_)
+{
+    struct thread_arg *arg = arg_;
+
+    while (!atomic_load(&owner_done) || !u64_wsdeque_is_empty(arg->deq_p)) {
+        uint64_t value;
+        if (u64_wsdeque_steal(arg->deq_p, &value)) {
+            taken[value]++;
+            arg->sum += value;
+            arg->count++;
+        }
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    // N = 0
+    {
+        struct u64_wsdeque *deq_p = u64_wsdeque_create(0);
+        if (deq_p) {
+            assert(false);
+        }
+        deq_p = u64_wsdeque_create(1);
+        if (!deq_p) {
+            assert(false);
+        }
+        uint64_t value;
+        assert(u64_wsdeque_is_empty(deq_p));
+        assert(!u64_wsdeque_pop(deq_p, &value));
+        assert(!u64_wsdeque_steal(deq_p, &value));
+        assert(u64_wsdeque_count(deq_p) == 0);
+
+        u64_wsdeque_destroy(deq_p);
+    }
+    // N = 1, push -> pop -> push -> steal
+    {
+        struct u64_wsdeque *deq_p = u64_wsdeque_create(1);
+        if (!deq_p) {
+            assert(false);
+        }
+        uint64_t value = 0;
+        assert(u64_wsdeque_push(deq_p, 42));
+        assert(u64_wsdeque_count(deq_p) == 1);
+        assert(u64_wsdeque_pop(deq_p, &value) && value == 42);
+        assert(u64_wsdeque_is_empty(deq_p));
+
+        assert(u64_wsdeque_push(deq_p, 43));
+        assert(u64_wsdeque_steal(deq_p, &value) && value == 43);
+        assert(u64_wsdeque_is_empty(deq_p));
+        assert(!u64_wsdeque_pop(deq_p, &value));
+
+        u64_wsdeque_destroy(deq_p);
+    }
+    // N = 10, (push * 3 -> steal * 2) -> push * 10 -> steal * 3 -> pop * 6
+    {
+        struct u64_wsdeque *deq_p = u64_wsdeque_create(4);
+        if (!deq_p) {
+            assert(false);
+        }
+        uint64_t value = 0;
+
+        /* move the top, such that the values wrap around the array before it is grown */
+        for (uint64_t i = 0; i < 3; i++) {
+            assert(u64_wsdeque_push(deq_p, 100 + i));
+        }
+        assert(u64_wsdeque_steal(deq_p, &value) && value == 100);
+        assert(u64_wsdeque_steal(deq_p, &value) && value == 101);
+
+        for (uint64_t i = 0; i < 10; i++) {
+            assert(u64_wsdeque_push(deq_p, i));
+        }
+        assert(u64_wsdeque_count(deq_p) == 11);
+
+        /* thieves take the oldest values, the owner the newest */
+        assert(u64_wsdeque_steal(deq_p, &value) && value == 102);
+        assert(u64_wsdeque_steal(deq_p, &value) && value == 0);
+        assert(u64_wsdeque_steal(deq_p, &value) && value == 1);
+        for (uint64_t i = 9; i >= 4; i--) {
+            assert(u64_wsdeque_pop(deq_p, &value) && value == i);
+        }
+        assert(u64_wsdeque_count(deq_p) == 2);
+
+        u64_wsdeque_destroy(deq_p);
+    }
+    // N = 1e+6, owner pushes and pops, thieves steal
+    {
+        struct u64_wsdeque *deq_p = u64_wsdeque_create(8);
+        if (!deq_p) {
+            assert(false);
+        }
+        atomic_store(&owner_done, false);
+
+        pthread_t thieves[THIEF_COUNT];
+        struct thread_arg args[THIEF_COUNT];
+        for (uint32_t i = 0; i < THIEF_COUNT; i++) {
+            args[i] = (struct thread_arg){.deq_p = deq_p, .sum = 0, .count = 0};
+            pthread_create(&thieves[i], NULL, thief, &args[i]);
+        }
+
+        uint64_t owner_sum = 0;
+        uint64_t owner_count = 0;
+        for (uint64_t i = 0; i < VALUE_COUNT; i++) {
+            assert(u64_wsdeque_push(deq_p, i));
+
+            uint64_t value;
+            if (i % 3 == 0 && u64_wsdeque_pop(deq_p, &value)) {
+                taken[value]++;
+                owner_sum += value;
+                owner_count++;
+            }
+        }
+        atomic_store(&owner_done, true);
+
+        uint64_t sum = owner_sum;
+        uint64_t count = owner_count;
+        for (uint32_t i = 0; i < THIEF_COUNT; i++) {
+            pthread_join(thieves[i], NULL);
+            sum += args[i].sum;
+            count += args[i].count;
+        }
+
+        assert(count == VALUE_COUNT);
+        assert(sum == (uint64_t)VALUE_COUNT * (VALUE_COUNT - 1) / 2);
+        for (uint64_t i = 0; i < VALUE_COUNT; i++) {
+            assert(taken[i] == 1);
+        }
+        assert(u64_wsdeque_is_empty(deq_p));
+
+        u64_wsdeque_destroy(deq_p);
+    }
+}